@@ -4,22 +4,36 @@ namespace Starlight
 {
 	void BacktraceBuffer::EnableBacktraceBuffer(size_t messageCount)
 	{
-		m_MaximumBufferSize = messageCount;
+		if (messageCount != m_LogPackages.size())
+		{
+			m_LogPackages.assign(messageCount, LogPackage());
+			ClearBuffer();
+		}
 	}
 
 	void BacktraceBuffer::PushBackLogPackage(const LogPackage& logPackage)
 	{
-		//Prevent overflowing.
-		if (m_LogPackages.size() + 1 > m_MaximumBufferSize)
+		if (m_LogPackages.empty())
 		{
-			m_LogPackages.erase(m_LogPackages.begin());
+			return;
 		}
 
-		m_LogPackages.push_back(logPackage);
+		//Once full, the newest package takes the place of the oldest.
+		if (m_PackageCount < m_LogPackages.size())
+		{
+			m_LogPackages[(m_OldestIndex + m_PackageCount) % m_LogPackages.size()] = logPackage;
+			m_PackageCount++;
+		}
+		else
+		{
+			m_LogPackages[m_OldestIndex] = logPackage;
+			m_OldestIndex = (m_OldestIndex + 1) % m_LogPackages.size();
+		}
 	}
 
 	void BacktraceBuffer::ClearBuffer()
 	{
-		m_LogPackages.clear();
+		m_OldestIndex = 0;
+		m_PackageCount = 0;
 	}
-}
\ No newline at end of file
+}
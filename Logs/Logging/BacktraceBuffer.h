@@ -4,6 +4,10 @@
 
 namespace Starlight
 {
+	/*
+		Circular buffer of the most recent log packages. Slots are allocated once, when the buffer is enabled, and reused in place from then on: a push 
+		overwrites the oldest package by assignment, which keeps the capacity of its strings, so a warmed up buffer neither allocates nor shifts on push.
+	*/
 	class BacktraceBuffer
 	{
 	public:
@@ -11,10 +15,21 @@ namespace Starlight
 		void PushBackLogPackage(const LogPackage& logPackage);
 		void ClearBuffer();
 
-		std::vector<LogPackage>& RetrieveLogPackages() { return m_LogPackages; }
+		// Visits the stored packages in place, oldest first.
+		template <typename Function>
+		void ForEachLogPackage(Function&& function) const
+		{
+			for (size_t i = 0; i < m_PackageCount; ++i)
+			{
+				function(m_LogPackages[(m_OldestIndex + i) % m_LogPackages.size()]);
+			}
+		}
+
+		size_t GetPackageCount() const { return m_PackageCount; }
 
 	private:
-		size_t m_MaximumBufferSize;
 		std::vector<LogPackage> m_LogPackages;
+		size_t m_OldestIndex = 0;
+		size_t m_PackageCount = 0;
 	};
 }
@@ -0,0 +1,246 @@
+#include "FileSink.h"
+#include "FileSystemA.h"
+#include <ctime>
+#include <filesystem>
+
+namespace Starlight
+{
+	FileSink::FileSink(const FileSinkSettings& fileSinkSettings) : m_Settings(fileSinkSettings)
+	{
+
+	}
+
+	FileSink::~FileSink()
+	{
+		Close();
+	}
+
+	bool FileSink::Open(const std::string& filePath)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			m_BaseFilePath = filePath;
+			m_FileIndex = 0;
+
+			if (!OpenFile(filePath))
+			{
+				return false;
+			}
+		}
+
+		StartFlushThread();
+
+		return true;
+	}
+
+	bool FileSink::OpenFile(const std::string& filePath)
+	{
+		CloseFile();
+
+		m_File.open(filePath, std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+		if (!m_File.is_open())
+		{
+			return false;
+		}
+
+		m_FilePath = filePath;
+		m_FileSize = static_cast<size_t>(m_File.tellp());
+		m_Buffer.reserve(m_Settings.m_BufferSize);
+		m_LastFlushTime = std::chrono::steady_clock::now();
+
+		return true;
+	}
+
+	void FileSink::Close()
+	{
+		StopFlushThread();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		CloseFile();
+	}
+
+	void FileSink::CloseFile()
+	{
+		if (m_File.is_open())
+		{
+			WriteBuffer();
+			m_File.close();
+		}
+	}
+
+	bool FileSink::IsOpen() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_File.is_open();
+	}
+
+	void FileSink::Write(std::string_view logLine, LogLevel logLevel)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_File.is_open())
+		{
+			return;
+		}
+
+		if (m_DailyRotation && std::chrono::system_clock::now() >= m_NextRotationTime)
+		{
+			RotateDaily();
+		}
+
+		if (m_Settings.m_MaxFileSize > 0 && m_FileSize + m_Buffer.size() + logLine.size() > m_Settings.m_MaxFileSize && m_FileSize + m_Buffer.size() > 0)
+		{
+			RotateBySize();
+		}
+
+		m_Buffer.append(logLine.data(), logLine.size());
+
+		if (m_Buffer.size() >= m_Settings.m_BufferSize || logLevel >= m_Settings.m_FlushLevel || std::chrono::steady_clock::now() - m_LastFlushTime >= m_Settings.m_FlushInterval)
+		{
+			FlushFile();
+		}
+	}
+
+	void FileSink::Flush()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		FlushFile();
+	}
+
+	void FileSink::FlushFile()
+	{
+		WriteBuffer();
+		m_File.flush();
+	}
+
+	void FileSink::SetSettings(const FileSinkSettings& fileSinkSettings)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Settings = fileSinkSettings;
+		}
+
+		m_FlushCondition.notify_one();  // Picks up the new interval.
+	}
+
+	void FileSink::EnableDailyRotation(int hour, int minutes)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_DailyRotation = true;
+		m_RotationHour = hour;
+		m_RotationMinutes = minutes;
+
+		ScheduleDailyRotation();
+	}
+
+	void FileSink::DisableDailyRotation()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_DailyRotation = false;
+	}
+
+	void FileSink::WriteBuffer()
+	{
+		if (!m_Buffer.empty())
+		{
+			m_File.write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+			m_FileSize += m_Buffer.size();
+			m_Buffer.clear();
+		}
+
+		m_LastFlushTime = std::chrono::steady_clock::now();
+	}
+
+	void FileSink::RotateBySize()
+	{
+		const std::filesystem::path basePath(m_BaseFilePath);
+
+		std::filesystem::path rotatedPath = basePath.parent_path() / basePath.stem();
+		rotatedPath += "_" + std::to_string(++m_FileIndex);
+		rotatedPath += basePath.extension();
+
+		OpenFile(rotatedPath.string());
+	}
+
+	void FileSink::RotateDaily()
+	{
+		m_BaseFilePath = FileSystemA::CreateNewFile(RetrieveCurrentTime(LogTimeMode::File));
+		m_FileIndex = 0;
+
+		OpenFile(m_BaseFilePath);
+		ScheduleDailyRotation();
+	}
+
+	// The next time the clock reads the rotation time, today if it is still ahead, tomorrow otherwise.
+	void FileSink::ScheduleDailyRotation()
+	{
+		const std::chrono::system_clock::time_point timeNow = std::chrono::system_clock::now();
+		const time_t currentTime = std::chrono::system_clock::to_time_t(timeNow);
+
+		std::tm rotationTime;
+		localtime_s(&rotationTime, &currentTime);
+		rotationTime.tm_hour = m_RotationHour;
+		rotationTime.tm_min = m_RotationMinutes;
+		rotationTime.tm_sec = 0;
+		rotationTime.tm_isdst = -1;
+
+		m_NextRotationTime = std::chrono::system_clock::from_time_t(std::mktime(&rotationTime));
+		if (m_NextRotationTime <= timeNow)
+		{
+			rotationTime.tm_mday += 1;
+			rotationTime.tm_isdst = -1;
+			m_NextRotationTime = std::chrono::system_clock::from_time_t(std::mktime(&rotationTime));
+		}
+	}
+
+	void FileSink::StartFlushThread()
+	{
+		if (!m_FlushThread.joinable())
+		{
+			m_FlushThread = std::thread(&FileSink::FlushLoop, this);
+		}
+	}
+
+	void FileSink::StopFlushThread()
+	{
+		if (!m_FlushThread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_IsStopping = true;
+		}
+
+		m_FlushCondition.notify_one();
+		m_FlushThread.join();
+		m_IsStopping = false;
+	}
+
+	// Sleeps until the buffered lines are due, or for a whole interval while there are none, so that a quiet log still reaches the file.
+	void FileSink::FlushLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		while (!m_IsStopping)
+		{
+			if (m_Settings.m_FlushInterval <= std::chrono::milliseconds::zero())
+			{
+				m_FlushCondition.wait(lock);  // Every line is flushed as it arrives.
+				continue;
+			}
+
+			const std::chrono::steady_clock::time_point timeNow = std::chrono::steady_clock::now();
+			if (!m_Buffer.empty() && m_File.is_open() && timeNow - m_LastFlushTime >= m_Settings.m_FlushInterval)
+			{
+				FlushFile();
+				continue;
+			}
+
+			m_FlushCondition.wait_until(lock, m_Buffer.empty() ? timeNow + m_Settings.m_FlushInterval : m_LastFlushTime + m_Settings.m_FlushInterval);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "LogUtilities.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace Starlight
+{
+	struct FileSinkSettings
+	{
+		size_t m_BufferSize = 64 * 1024;												// Buffered bytes that trigger a write to the file.
+		std::chrono::milliseconds m_FlushInterval = std::chrono::milliseconds(1000);	// Roughly the longest a line is held back for, however long the next line takes.
+		LogLevel m_FlushLevel = LogLevel::Error;										// Lines at or above this level are written out straight away.
+		size_t m_MaxFileSize = 0;														// Size in bytes past which the file is rotated. 0 never rotates by size.
+	};
+
+	/*
+		Keeps a log file open and appends lines to it through a large buffer, instead of opening the file for every line. The buffer is written out 
+		when it fills, when the flush interval has passed, when a line at the flush level arrives, and on Flush, Close and destruction. While the file
+		is open, a background thread wakes every flush interval to write out lines that no later line has pushed out.
+
+		Files can be rotated by size, continuing in "<name>_1.txt", "<name>_2.txt" and so on, and daily, at a set local time, continuing in a new 
+		file named after the time of rotation, as startup logging does.
+	*/
+	class FileSink
+	{
+	public:
+		explicit FileSink(const FileSinkSettings& fileSinkSettings = FileSinkSettings());
+		~FileSink();
+
+		FileSink(const FileSink&) = delete;
+		FileSink& operator=(const FileSink&) = delete;
+
+		// Appends to the file at filePath, creating it if needed.
+		bool Open(const std::string& filePath);
+		void Close();
+		bool IsOpen() const;
+
+		void Write(std::string_view logLine, LogLevel logLevel);
+		void Flush();
+
+		void EnableDailyRotation(int hour, int minutes);
+		void DisableDailyRotation();
+
+		void SetSettings(const FileSinkSettings& fileSinkSettings);
+		const std::string& GetFilePath() const { return m_FilePath; }
+
+	private:
+		// Called with m_Mutex held.
+		bool OpenFile(const std::string& filePath);
+		void CloseFile();
+		void FlushFile();
+		void WriteBuffer();
+		void RotateBySize();
+		void RotateDaily();
+		void ScheduleDailyRotation();
+
+		void StartFlushThread();
+		void StopFlushThread();
+		void FlushLoop();
+
+	private:
+		FileSinkSettings m_Settings;
+
+		std::ofstream m_File;
+		std::string m_FilePath;
+		std::string m_BaseFilePath;		// Size rotated files are named after the file passed to Open.
+		size_t m_FileIndex = 0;
+		size_t m_FileSize = 0;
+
+		std::string m_Buffer;
+		std::chrono::steady_clock::time_point m_LastFlushTime;
+
+		bool m_DailyRotation = false;
+		int m_RotationHour = 0;
+		int m_RotationMinutes = 0;
+		std::chrono::system_clock::time_point m_NextRotationTime;
+
+		// Guards everything above against the flush thread. Logging itself isn't thread safe.
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_FlushCondition;
+		std::thread m_FlushThread;
+		bool m_IsStopping = false;
+	};
+}
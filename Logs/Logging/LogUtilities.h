@@ -3,8 +3,7 @@
 #include <iostream>
 #include <chrono>
 #include <cstring>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
 #include <string.h>
 #include <Windows.h>
 
@@ -26,6 +25,7 @@ enum LogTimeMode
 
 struct LogPackage
 {
+	LogPackage() = default;
 	LogPackage(const std::string& logMessage, const std::string& loggerName, const LogLevel& logLevel, const std::string& logTime) 
 		: m_LogMessage(logMessage), m_LoggerName(loggerName), m_LogLevel(logLevel), m_LogTime(logTime)
 	{
@@ -38,29 +38,58 @@ struct LogPackage
 	LogLevel m_LogLevel = LogLevel::TotalLevels;
 };
 
-inline std::string RetrieveCurrentTime(const LogTimeMode& timeMode)
+inline std::string FormatTime(time_t time, const LogTimeMode& timeMode)
 {
-	std::chrono::time_point currentTimePoint = std::chrono::system_clock::now();
-	time_t currentTime = std::chrono::system_clock::to_time_t(currentTimePoint);
 	std::tm buffer;
-	localtime_s(&buffer, &currentTime);
+	localtime_s(&buffer, &time);
 
-	std::stringstream transTime;
+	char timeText[64];
+	size_t timeLength = 0;
 
 	switch (timeMode)
 	{
 		case LogTimeMode::File:
-			transTime << std::put_time(&buffer, "%B_%d_%Y_%HH_%MM_%SS");
+			timeLength = strftime(timeText, sizeof(timeText), "%B_%d_%Y_%HH_%MM_%SS", &buffer);
 			break;
 
 		case LogTimeMode::Console:
-			transTime << std::put_time(&buffer, "%HH:%MM:%SS");
+			timeLength = strftime(timeText, sizeof(timeText), "%HH:%MM:%SS", &buffer);
 			break;
 	}
 
-	return transTime.str();
+	return std::string(timeText, timeLength);
 }
 
+inline std::string RetrieveCurrentTime(const LogTimeMode& timeMode)
+{
+	return FormatTime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()), timeMode);
+}
+
+// Same as RetrieveCurrentTime, but only formats again once the second changes. Not thread safe.
+class CurrentTimeCache
+{
+public:
+	explicit CurrentTimeCache(LogTimeMode timeMode) : m_TimeMode(timeMode) { }
+
+	const std::string& RetrieveCurrentTime()
+	{
+		const time_t currentTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+		if (currentTime != m_CachedTime || m_CachedText.empty())
+		{
+			m_CachedText = FormatTime(currentTime, m_TimeMode);
+			m_CachedTime = currentTime;
+		}
+
+		return m_CachedText;
+	}
+
+private:
+	LogTimeMode m_TimeMode;
+	time_t m_CachedTime = 0;
+	std::string m_CachedText;
+};
+
 const WORD BoldConsoleTextColor = FOREGROUND_INTENSITY;
 const WORD BlueConsoleTextColor = 11; 
 const WORD GreenConsoleTextColor = FOREGROUND_GREEN;
@@ -71,7 +71,7 @@ namespace Starlight
 
 	void Logger::WriteLogMessage(const std::string& logMessage, const LogLevel& logLevel)
 	{
-		LogPackage logPackage(logMessage, m_LoggerName, logLevel, RetrieveCurrentTime(LogTimeMode::Console));
+		LogPackage logPackage(logMessage, m_LoggerName, logLevel, m_ConsoleTimeCache.RetrieveCurrentTime());
 		PatternFormatter(logPackage);
 
 		if (m_LogBacktracing)
@@ -110,7 +110,7 @@ namespace Starlight
 			}
 
 			logPrefix.append(logPackage.m_LogMessage);
-			LogToFile(logPrefix);
+			LogToFile(logPrefix, logPackage.m_LogLevel);
 		}
 
 		LogString(logPackage);
@@ -141,19 +141,15 @@ namespace Starlight
 		m_ConsoleState.RestoreConsoleAttributes();
 	}
 
-	void Logger::LogToFile(const std::string& logMessage)
+	void Logger::LogToFile(const std::string& logMessage, LogLevel logLevel)
 	{
-		//Open a log file to write the messages to.
-		m_FileOut.open(m_LogFileName, std::ofstream::out | std::ofstream::app);
-
-		if (m_FileOut.is_open())
+		//The log file is opened on first use and kept open from then on.
+		if (!m_FileSink.IsOpen())
 		{
-			//Write out the error message.
-			m_FileOut << logMessage;
-
-			//Close the file.
-			m_FileOut.close();
+			m_FileSink.Open(m_LogFileName);
 		}
+
+		m_FileSink.Write(logMessage, logLevel);
 	}
 
 	//====================================================================================================
@@ -164,6 +160,11 @@ namespace Starlight
 		{
 			m_LogToFile = value;
 		}
+
+		if (!value)
+		{
+			m_FileSink.Close();
+		}
 	}
 
 	void Logger::EnableStartupLogging(bool value)
@@ -177,6 +178,11 @@ namespace Starlight
 		{
 			//Each time the program runs, we should create a new file with time and date as its name if enabled.
 			m_LogFileName = FileSystemA::CreateNewFile(RetrieveCurrentTime(LogTimeMode::File));
+
+			if (m_FileSink.IsOpen())
+			{
+				m_FileSink.Open(m_LogFileName);
+			}
 		}
 	}
 
@@ -187,12 +193,26 @@ namespace Starlight
 			m_DailyFileLogging = value;
 		}
 
-		if (m_LogToFile && value)
+		if (value)
 		{
-
+			m_FileSink.EnableDailyRotation(hour, minutes);
+		}
+		else
+		{
+			m_FileSink.DisableDailyRotation();
 		}
 	}
 
+	void Logger::SetFileLoggingSettings(const FileSinkSettings& fileSinkSettings)
+	{
+		m_FileSink.SetSettings(fileSinkSettings);
+	}
+
+	void Logger::FlushFileLog()
+	{
+		m_FileSink.Flush();
+	}
+
 	void Logger::EnableBacktracing(bool value, size_t messageCount)
 	{
 		if (value != m_LogBacktracing)
@@ -219,10 +239,7 @@ namespace Starlight
 			return;
 		}
 
-		for (const LogPackage& logPackage : m_BacktraceBuffer.RetrieveLogPackages())
-		{
-			LogString(logPackage);
-		}
+		m_BacktraceBuffer.ForEachLogPackage([this](const LogPackage& logPackage) { LogString(logPackage); });
 
 		m_BacktraceBuffer.ClearBuffer();
 	}
@@ -3,6 +3,7 @@
 #include "ConsoleState.h"
 #include "BacktraceBuffer.h"
 #include "FileSystemA.h"
+#include "FileSink.h"
 #include <string>
 #include <vector>
 #include <fstream>
@@ -35,13 +36,15 @@ namespace Starlight
 		void EnableFileLogging(bool value);
 		void EnableStartupLogging(bool value);
 		void EnableDailyLoggingTimer(bool value, int hour, int minutes);
+		void SetFileLoggingSettings(const FileSinkSettings& fileSinkSettings);
+		void FlushFileLog();
 
 	private:
 		std::string PatternFormatter(LogPackage& logPackage);
 		void WriteLogMessage(const std::string& logMessage , const LogLevel& logLevel);
 
 		void LogString(const LogPackage& logPackage); //Everything resolves to this.
-		void LogToFile(const std::string& logMessage);
+		void LogToFile(const std::string& logMessage, LogLevel logLevel);
 
 	private:
 		std::string m_LogFileName = "Logs/Log.txt";
@@ -58,8 +61,9 @@ namespace Starlight
 		bool m_LogBacktracing = false;
 		
 		ConsoleState m_ConsoleState;
+		CurrentTimeCache m_ConsoleTimeCache = CurrentTimeCache(LogTimeMode::Console);
 
 		//File Operations
-		std::ofstream m_FileOut;
+		FileSink m_FileSink;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace
+{
+    thread_local size_t t_AllocationCount = 0;  // Constant initialized, so it is safe to touch from within operator new.
+
+    // Calls the new handler until allocate succeeds, as the default operator new does.
+    template <typename Allocate>
+    void* AllocateOrThrow(Allocate allocate)
+    {
+        for (;;)
+        {
+            if (void* ptr = allocate())
+            {
+                return ptr;
+            }
+
+            std::new_handler newHandler = std::get_new_handler();
+            if (!newHandler)
+            {
+                throw std::bad_alloc();
+            }
+
+            newHandler();
+        }
+    }
+}
+
+namespace Benchmarks
+{
+    size_t AllocationCounter::GetThreadAllocationCount()
+    {
+        return t_AllocationCount;
+    }
+}
+
+#ifdef STARLIGHT_BENCHMARKS
+
+// Allocates with malloc, like the default, so that it pairs with the default and Debug/MemoryTracker.cpp's operator delete alike.
+void* operator new(std::size_t size)
+{
+    ++t_AllocationCount;
+
+    return AllocateOrThrow([size]() { return std::malloc(size > 0 ? size : 1); });
+}
+
+// Over-aligned types, such as RTTI::ObjectPool's blocks. Allocates as the default does, so that it pairs with the default aligned operator delete.
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    ++t_AllocationCount;
+
+    const std::size_t alignmentSize = static_cast<std::size_t>(alignment);
+
+#ifdef _MSC_VER
+    return AllocateOrThrow([size, alignmentSize]() { return _aligned_malloc(size > 0 ? size : 1, alignmentSize); });
+#else
+    // aligned_alloc takes sizes in multiples of the alignment.
+    const std::size_t alignedSize = ((size > 0 ? size : 1) + alignmentSize - 1) / alignmentSize * alignmentSize;
+    return AllocateOrThrow([alignedSize, alignmentSize]() { return std::aligned_alloc(alignmentSize, alignedSize); });
+#endif
+}
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+namespace Benchmarks
+{
+    /*
+        Counts the allocations made through the global operator new by the calling thread since the counter was constructed.
+
+        AllocationCounter.cpp replaces the global operator new, and its aligned overload, with ones that count before allocating, at the cost of a
+        thread local increment per allocation. Array and nothrow new go through them too. Deallocation is left alone. As that affects the whole
+        executable, the replacements only exist in the Benchmark configuration, which defines STARLIGHT_BENCHMARKS. Elsewhere, counts stay at 0.
+    */
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter() : m_StartCount(GetThreadAllocationCount()) { }
+
+        size_t GetCount() const { return GetThreadAllocationCount() - m_StartCount; }
+
+        static size_t GetThreadAllocationCount();
+
+    private:
+        size_t m_StartCount;
+    };
+}
@@ -0,0 +1,474 @@
+#include "LoggingBenchmark.h"
+#include "AllocationCounter.h"
+#include "../IO/FileSystem.h"
+#include "../Log/Logger.h"
+#include "../Log/LogMacros.h"
+#include "../Tools/LogDecoder.h"
+#include <json/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+// Last, as it brings in Windows.h and unscoped enumerations at global scope.
+#include "../../Logs/Logging/Logger.h"
+
+namespace Benchmarks
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const char* const g_StarlightLogFilePath = "Logs/Log.txt";  // Where Starlight::Logger writes, which it doesn't let us change.
+
+        // Counts the lines written to it and discards them. Safe to write to from several threads at once.
+        class LineCountingBuffer : public std::streambuf
+        {
+        public:
+            size_t GetLineCount() const { return m_LineCount.load(std::memory_order_relaxed); }
+
+        protected:
+            int_type overflow(int_type character) override
+            {
+                if (character == traits_type::to_int_type('\n'))
+                {
+                    m_LineCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return traits_type::not_eof(character);
+            }
+
+            std::streamsize xsputn(const char* text, std::streamsize length) override
+            {
+                m_LineCount.fetch_add(static_cast<size_t>(std::count(text, text + length, '\n')), std::memory_order_relaxed);
+                return length;
+            }
+
+        private:
+            std::atomic<size_t> m_LineCount = 0;
+        };
+
+        // Serializes writes to another buffer, as the console's own buffer does, so that synchronous logging from several threads can go to a file.
+        class SynchronizedBuffer : public std::streambuf
+        {
+        public:
+            explicit SynchronizedBuffer(std::streambuf* targetBuffer) : m_TargetBuffer(targetBuffer) { }
+
+        protected:
+            int_type overflow(int_type character) override
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                return traits_type::eq_int_type(character, traits_type::eof()) ? traits_type::not_eof(character) : m_TargetBuffer->sputc(traits_type::to_char_type(character));
+            }
+
+            std::streamsize xsputn(const char* text, std::streamsize length) override
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                return m_TargetBuffer->sputn(text, length);
+            }
+
+            int sync() override
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                return m_TargetBuffer->pubsync();
+            }
+
+        private:
+            std::mutex m_Mutex;
+            std::streambuf* m_TargetBuffer;
+        };
+
+        // Swaps std::cout's buffer for the lifetime of the object.
+        class ConsoleRedirect
+        {
+        public:
+            explicit ConsoleRedirect(std::streambuf* buffer) : m_ConsoleBuffer(std::cout.rdbuf(buffer)) { }
+            ~ConsoleRedirect() { std::cout.rdbuf(m_ConsoleBuffer); }
+
+            ConsoleRedirect(const ConsoleRedirect&) = delete;
+            ConsoleRedirect& operator=(const ConsoleRedirect&) = delete;
+
+        private:
+            std::streambuf* m_ConsoleBuffer;
+        };
+
+        size_t CountLines(const std::string& filePath, uintmax_t startOffset)
+        {
+            std::ifstream inputFile(filePath, std::ios::binary);
+            inputFile.seekg(static_cast<std::streamoff>(startOffset));
+
+            return static_cast<size_t>(std::count(std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>(), '\n'));
+        }
+
+        uintmax_t GetLogFileSize(const std::string& filePath)
+        {
+            std::error_code errorCode;
+            const uintmax_t fileSize = std::filesystem::file_size(filePath, errorCode);
+
+            return errorCode ? 0 : fileSize;
+        }
+
+        // The average cost of a steady clock read, which every latency measured includes once.
+        double MeasureClockNanoseconds()
+        {
+            constexpr size_t readCount = 1000000;
+
+            const Clock::time_point startTime = Clock::now();
+            Clock::time_point lastTime = startTime;
+            for (size_t i = 0; i < readCount; ++i)
+            {
+                lastTime = Clock::now();
+            }
+
+            return std::chrono::duration<double, std::nano>(lastTime - startTime).count() / readCount;
+        }
+
+        double GetPercentile(const std::vector<int64_t>& sortedLatencies, double percentile)
+        {
+            if (sortedLatencies.empty())
+            {
+                return 0.0;
+            }
+
+            const size_t index = (std::min)(sortedLatencies.size() - 1, static_cast<size_t>(percentile * sortedLatencies.size()));
+            return static_cast<double>(sortedLatencies[index]);
+        }
+
+        /*
+            Starts threadCount threads together, which make messageCount calls to logMessage between them, each at most messagesPerSecond. Every
+            call is timed on its own. Once they finish, flush is called, which must return once everything logged has been output.
+        */
+        template <typename LogFunction, typename FlushFunction>
+        LoggingBenchmarkResult Measure(const std::string& loggerName, const std::string& modeName, const std::string& sinkName, unsigned int threadCount, size_t messageCount, double messagesPerSecond,
+                                       const LogFunction& logMessage, const FlushFunction& flush)
+        {
+            LoggingBenchmarkResult result;
+            result.m_Logger = loggerName;
+            result.m_Mode = modeName;
+            result.m_Sink = sinkName;
+            result.m_ThreadCount = (std::max)(threadCount, 1u);
+            result.m_MessageCount = messageCount;
+
+            std::vector<std::vector<int64_t>> threadLatencies(result.m_ThreadCount);
+            std::vector<size_t> threadAllocationCounts(result.m_ThreadCount, 0);
+            std::vector<std::thread> threads;
+
+            std::atomic<bool> isStarted = false;
+            Clock::time_point startTime;
+
+            for (unsigned int threadIndex = 0; threadIndex < result.m_ThreadCount; ++threadIndex)
+            {
+                const size_t threadMessageCount = messageCount / result.m_ThreadCount + (threadIndex < messageCount % result.m_ThreadCount ? 1 : 0);
+                threadLatencies[threadIndex].resize(threadMessageCount);
+
+                threads.emplace_back([&, threadIndex, threadMessageCount]()
+                {
+                    std::vector<int64_t>& latencies = threadLatencies[threadIndex];
+                    const Clock::duration messageInterval = messagesPerSecond > 0.0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / messagesPerSecond)) : Clock::duration::zero();
+
+                    while (!isStarted.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    AllocationCounter allocationCounter;
+
+                    for (size_t i = 0; i < threadMessageCount; ++i)
+                    {
+                        if (messageInterval > Clock::duration::zero())
+                        {
+                            const Clock::time_point messageTime = startTime + messageInterval * static_cast<Clock::rep>(i);
+                            while (Clock::now() < messageTime)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+
+                        const Clock::time_point callTime = Clock::now();
+                        logMessage(i);
+                        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - callTime).count();
+                    }
+
+                    threadAllocationCounts[threadIndex] = allocationCounter.GetCount();
+                });
+            }
+
+            startTime = Clock::now();
+            isStarted.store(true, std::memory_order_release);
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            flush();
+            result.m_Seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+            std::vector<int64_t> latencies;
+            latencies.reserve(messageCount);
+            for (unsigned int threadIndex = 0; threadIndex < result.m_ThreadCount; ++threadIndex)
+            {
+                latencies.insert(latencies.end(), threadLatencies[threadIndex].begin(), threadLatencies[threadIndex].end());
+                result.m_AllocationCount += threadAllocationCounts[threadIndex];
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+            result.m_P50Nanoseconds = GetPercentile(latencies, 0.5);
+            result.m_P99Nanoseconds = GetPercentile(latencies, 0.99);
+            result.m_P999Nanoseconds = GetPercentile(latencies, 0.999);
+            result.m_MaxNanoseconds = latencies.empty() ? 0.0 : static_cast<double>(latencies.back());
+
+            return result;
+        }
+
+        void PrintResult(const LoggingBenchmarkResult& result)
+        {
+            std::printf("%-9s %-5s %-11s | %2u Threads | %8zu Msgs | p50 %8.0f ns | p99 %8.0f ns | p99.9 %9.0f ns | %11.0f Msgs/s | %5.2f allocs/msg | %s\n", result.m_Logger.c_str(),
+                        result.m_Mode.c_str(), result.m_Sink.c_str(), result.m_ThreadCount, result.m_MessageCount, result.m_P50Nanoseconds, result.m_P99Nanoseconds, result.m_P999Nanoseconds,
+                        result.GetMessagesPerSecond(), result.GetAllocationsPerMessage(), result.m_IsVerified ? "Verified" : "MISMATCH");
+        }
+
+        void LogAuroraMessage(size_t messageIndex)
+        {
+            AURORA_INFO(Aurora::LogLayer::Engine, "Frame {} took {:.3f} ms, entities {}", messageIndex, messageIndex * 0.016, 1000 + messageIndex % 7);
+        }
+
+        void MeasureAurora(const LoggingBenchmarkSettings& settings, const std::filesystem::path& workingDirectory, std::vector<LoggingBenchmarkResult>& results)
+        {
+            Aurora::Logger& logger = Aurora::Logger::GetInstance();
+            const auto flush = [&]() { logger.Flush(); };
+
+            const std::string textLogPath = (workingDirectory / "LoggingBenchmark_Aurora.log").string();
+            const std::string binaryLogPath = (workingDirectory / "LoggingBenchmark_Aurora.alog").string();
+
+            for (const bool isAsync : { false, true })
+            {
+                const char* modeName = isAsync ? "Async" : "Sync";
+
+                for (const unsigned int threadCount : settings.m_ThreadCounts)
+                {
+                    if (isAsync)
+                    {
+                        logger.EnableAsyncMode();
+                    }
+
+                    {
+                        LineCountingBuffer lineCountingBuffer;
+                        LoggingBenchmarkResult result;
+                        {
+                            ConsoleRedirect consoleRedirect(&lineCountingBuffer);
+                            result = Measure("Aurora", modeName, "Null", threadCount, settings.m_MessageCount, settings.m_MessagesPerSecond, &LogAuroraMessage, flush);
+                        }
+
+                        result.m_IsVerified = lineCountingBuffer.GetLineCount() == result.m_MessageCount;
+                        PrintResult(result);
+                        results.push_back(result);
+                    }
+
+                    {
+                        std::filebuf fileBuffer;
+                        fileBuffer.open(textLogPath, std::ios::out | std::ios::trunc | std::ios::binary);
+                        SynchronizedBuffer synchronizedBuffer(&fileBuffer);
+
+                        LoggingBenchmarkResult result;
+                        {
+                            ConsoleRedirect consoleRedirect(&synchronizedBuffer);
+                            result = Measure("Aurora", modeName, "File", threadCount, settings.m_MessageCount, settings.m_MessagesPerSecond, &LogAuroraMessage, flush);
+                        }
+
+                        fileBuffer.close();
+                        result.m_IsVerified = CountLines(textLogPath, 0) == result.m_MessageCount;
+                        PrintResult(result);
+                        results.push_back(result);
+                    }
+
+                    {
+                        logger.EnableBinaryLogging(binaryLogPath);
+                        LoggingBenchmarkResult result = Measure("Aurora", modeName, "Binary File", threadCount, settings.m_MessageCount, settings.m_MessagesPerSecond, &LogAuroraMessage, flush);
+                        logger.DisableBinaryLogging();
+
+                        size_t decodedCount = 0;
+                        const bool isDecoded = Tools::LogDecoder::DecodeFile(binaryLogPath, [&](const Tools::DecodedLogRecord&) { ++decodedCount; });
+
+                        result.m_IsVerified = isDecoded && decodedCount == result.m_MessageCount;
+                        PrintResult(result);
+                        results.push_back(result);
+                    }
+
+                    if (settings.m_ConsoleMessageCount > 0)
+                    {
+                        LoggingBenchmarkResult result = Measure("Aurora", modeName, "Console", threadCount, settings.m_ConsoleMessageCount, settings.m_MessagesPerSecond, &LogAuroraMessage, flush);
+
+                        result.m_IsVerified = true;
+                        PrintResult(result);
+                        results.push_back(result);
+                    }
+
+                    if (isAsync)
+                    {
+                        logger.DisableAsyncMode();
+                    }
+                }
+            }
+        }
+
+        void MeasureStarlight(const LoggingBenchmarkSettings& settings, std::vector<LoggingBenchmarkResult>& results)
+        {
+            std::mutex loggerMutex;
+
+            for (const unsigned int threadCount : settings.m_ThreadCounts)
+            {
+                {
+                    Starlight::Logger logger("Benchmark");
+                    LineCountingBuffer lineCountingBuffer;
+
+                    const auto logMessage = [&](size_t messageIndex)
+                    {
+                        std::lock_guard<std::mutex> lock(loggerMutex);
+                        logger.WriteInfoLog("Frame %zu took %.3f ms, entities %d", messageIndex, messageIndex * 0.016, static_cast<int>(1000 + messageIndex % 7));
+                    };
+
+                    LoggingBenchmarkResult result;
+                    {
+                        ConsoleRedirect consoleRedirect(&lineCountingBuffer);
+                        result = Measure("Starlight", "Sync", "Null", threadCount, settings.m_MessageCount, settings.m_MessagesPerSecond, logMessage, []() { std::cout.flush(); });
+                    }
+
+                    result.m_IsVerified = lineCountingBuffer.GetLineCount() == result.m_MessageCount;
+                    PrintResult(result);
+                    results.push_back(result);
+                }
+
+                {
+                    IO::FileSystem::CreateDirectory_("Logs");
+                    const uintmax_t startSize = GetLogFileSize(g_StarlightLogFilePath);
+
+                    Starlight::Logger logger("Benchmark");
+                    logger.EnableFileLogging(true);
+                    LineCountingBuffer lineCountingBuffer;
+
+                    const auto logMessage = [&](size_t messageIndex)
+                    {
+                        std::lock_guard<std::mutex> lock(loggerMutex);
+                        logger.WriteInfoLog("Frame %zu took %.3f ms, entities %d", messageIndex, messageIndex * 0.016, static_cast<int>(1000 + messageIndex % 7));
+                    };
+
+                    LoggingBenchmarkResult result;
+                    {
+                        ConsoleRedirect consoleRedirect(&lineCountingBuffer);
+                        result = Measure("Starlight", "Sync", "File", threadCount, settings.m_MessageCount, settings.m_MessagesPerSecond, logMessage, [&]() { logger.FlushFileLog(); });
+                    }
+
+                    logger.EnableFileLogging(false);
+                    result.m_IsVerified = CountLines(g_StarlightLogFilePath, startSize) == result.m_MessageCount;
+                    PrintResult(result);
+                    results.push_back(result);
+                }
+
+                if (settings.m_ConsoleMessageCount > 0)
+                {
+                    Starlight::Logger logger("Benchmark");
+
+                    const auto logMessage = [&](size_t messageIndex)
+                    {
+                        std::lock_guard<std::mutex> lock(loggerMutex);
+                        logger.WriteInfoLog("Frame %zu took %.3f ms, entities %d", messageIndex, messageIndex * 0.016, static_cast<int>(1000 + messageIndex % 7));
+                    };
+
+                    LoggingBenchmarkResult result = Measure("Starlight", "Sync", "Console", threadCount, settings.m_ConsoleMessageCount, settings.m_MessagesPerSecond, logMessage, []() { std::cout.flush(); });
+
+                    result.m_IsVerified = true;
+                    PrintResult(result);
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    std::vector<LoggingBenchmarkResult> LoggingBenchmark::Run(const LoggingBenchmarkSettings& settings)
+    {
+        const std::filesystem::path workingDirectory = settings.m_WorkingDirectory.empty() ? std::filesystem::current_path() : std::filesystem::path(settings.m_WorkingDirectory);
+        const double clockNanoseconds = MeasureClockNanoseconds();
+
+        std::printf("Logging Benchmark | %zu Messages | %zu Console Messages | %.0f Msgs/s Per Thread | Clock Read %.1f ns\n", settings.m_MessageCount, settings.m_ConsoleMessageCount,
+                    settings.m_MessagesPerSecond, clockNanoseconds);
+
+        std::vector<LoggingBenchmarkResult> results;
+        MeasureAurora(settings, workingDirectory, results);
+        MeasureStarlight(settings, results);
+
+        if (!settings.m_ResultsPath.empty())
+        {
+            nlohmann::json report;
+            report["Benchmark"] = "Logging";
+            report["MessageCount"] = settings.m_MessageCount;
+            report["ConsoleMessageCount"] = settings.m_ConsoleMessageCount;
+            report["ThreadCounts"] = settings.m_ThreadCounts;
+            report["MessagesPerSecond"] = settings.m_MessagesPerSecond;
+            report["ClockNanoseconds"] = clockNanoseconds;
+
+            for (const LoggingBenchmarkResult& result : results)
+            {
+                report["Results"].push_back(
+                {
+                    { "Logger", result.m_Logger },
+                    { "Mode", result.m_Mode },
+                    { "Sink", result.m_Sink },
+                    { "ThreadCount", result.m_ThreadCount },
+                    { "MessageCount", result.m_MessageCount },
+                    { "Seconds", result.m_Seconds },
+                    { "MessagesPerSecond", result.GetMessagesPerSecond() },
+                    { "P50Nanoseconds", result.m_P50Nanoseconds },
+                    { "P99Nanoseconds", result.m_P99Nanoseconds },
+                    { "P999Nanoseconds", result.m_P999Nanoseconds },
+                    { "MaxNanoseconds", result.m_MaxNanoseconds },
+                    { "AllocationsPerMessage", result.GetAllocationsPerMessage() },
+                    { "Verified", result.m_IsVerified }
+                });
+            }
+
+            std::ofstream resultsFile(settings.m_ResultsPath);
+            resultsFile << report.dump(4) << "\n";
+            std::printf("Results written to %s\n", settings.m_ResultsPath.c_str());
+        }
+
+        return results;
+    }
+
+    int LoggingBenchmark::RunFromCommandLine(int argc, char* argv[])
+    {
+        LoggingBenchmarkSettings settings;
+        if (argc > 0)
+        {
+            settings.m_MessageCount = static_cast<size_t>(std::strtoull(argv[0], nullptr, 10));
+        }
+
+        if (argc > 1)
+        {
+            settings.m_MessagesPerSecond = std::strtod(argv[1], nullptr);
+        }
+
+        if (argc > 2)
+        {
+            settings.m_ThreadCounts = { static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) };
+        }
+
+        if (argc > 3)
+        {
+            settings.m_ResultsPath = argv[3];
+        }
+
+        const std::vector<LoggingBenchmarkResult> results = Run(settings);
+        const bool isAllVerified = std::all_of(results.begin(), results.end(), [](const LoggingBenchmarkResult& result) { return result.m_IsVerified; });
+
+        return isAllVerified ? 0 : 1;
+    }
+}
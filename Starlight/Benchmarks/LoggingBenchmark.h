@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+    struct LoggingBenchmarkSettings
+    {
+        size_t m_MessageCount = 200000;                         // Messages per case, split evenly between its threads.
+        size_t m_ConsoleMessageCount = 5000;                    // Console cases are slow and fill the terminal, so they log fewer. 0 skips them.
+        std::vector<unsigned int> m_ThreadCounts = { 1, 4 };    // Logging thread counts to run every case with.
+        double m_MessagesPerSecond = 0.0;                       // Rate each thread logs at. 0 logs as fast as possible.
+        std::string m_WorkingDirectory = "";                    // Where the Aurora log files are written. Empty uses the current directory.
+        std::string m_ResultsPath = "LoggingBenchmark.json";    // Machine readable results. Empty skips writing them.
+    };
+
+    struct LoggingBenchmarkResult
+    {
+        std::string m_Logger;           // "Aurora" or "Starlight".
+        std::string m_Mode;             // "Sync" or "Async".
+        std::string m_Sink;             // "Null", "File", "Binary File" or "Console".
+        unsigned int m_ThreadCount = 0;
+        size_t m_MessageCount = 0;
+        double m_Seconds = 0.0;         // From the threads starting until every message has been output.
+        double m_P50Nanoseconds = 0.0;  // Latencies of the logging calls, as seen by the logging threads.
+        double m_P99Nanoseconds = 0.0;
+        double m_P999Nanoseconds = 0.0;
+        double m_MaxNanoseconds = 0.0;
+        size_t m_AllocationCount = 0;   // Made by the logging threads. Allocations on Aurora's backend thread aren't counted.
+        bool m_IsVerified = false;      // Every message reached the sink, where that can be checked.
+
+        double GetMessagesPerSecond() const { return m_Seconds > 0.0 ? m_MessageCount / m_Seconds : 0.0; }
+        double GetAllocationsPerMessage() const { return m_MessageCount > 0 ? static_cast<double>(m_AllocationCount) / m_MessageCount : 0.0; }
+    };
+
+    /*
+        Measures Aurora::Logger and Starlight::Logger with a number of threads logging the same message, with three arguments, at a set rate.
+        Each case reports the percentiles of the time taken by the logging calls, the throughput including the time to flush, and the
+        allocations made per message.
+
+        - Null: console output goes to a stream buffer that only counts lines, leaving the cost of capturing and formatting messages.
+        - File: Aurora's console output is sent to a file. Starlight's file logging is enabled, writing to Logs/Log.txt as usual, with its console
+          output counted as with Null.
+        - Binary File: Aurora's binary logging. See Log/BinaryLogSink.h.
+        - Console: the real console.
+
+        Aurora cases run synchronously and in asynchronous mode. Starlight::Logger isn't thread safe, so its calls are made under a lock, which
+        the latencies include. Latencies also include a clock read, the cost of which is reported alongside.
+    */
+    class LoggingBenchmark
+    {
+    public:
+        static std::vector<LoggingBenchmarkResult> Run(const LoggingBenchmarkSettings& settings);
+
+        // Usage: benchmark-logging [messageCount] [messagesPerSecond] [threadCount] [resultsPath]. Returns the process exit code.
+        static int RunFromCommandLine(int argc, char* argv[]);
+    };
+}
@@ -0,0 +1,512 @@
+#include "RTTIBenchmark.h"
+#include "AllocationCounter.h"
+#include "../RTTI/Reflect.hpp"
+#include <json/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <utility>
+
+namespace Benchmarks
+{
+    namespace
+    {
+        constexpr size_t ConstructionBatchSize = 64;  // Instances per pooled NewInstances call.
+
+        class BenchmarkAccumulator
+        {
+        public:
+            double Accumulate(double value, int weight)
+            {
+                m_Total += value * weight;
+                return m_Total;
+            }
+
+            double GetTotal() const { return m_Total; }
+            void Reset() { m_Total = 0.0; }
+
+        private:
+            double m_Total = 0.0;
+        };
+
+        struct BenchmarkVector
+        {
+            BenchmarkVector() = default;
+            BenchmarkVector(float x, float y, float z) : m_X(x), m_Y(y), m_Z(z) { }
+
+            float m_X = 0.0f;
+            float m_Y = 0.0f;
+            float m_Z = 0.0f;
+        };
+
+        // Too large for Any's inline buffer, so Any stores it on the heap.
+        struct BenchmarkPayload
+        {
+            double m_Values[16] = { 1.0 };
+        };
+
+        // Carries the data members for member lookups. Every registered name refers to the same field.
+        struct BenchmarkMembers
+        {
+            int m_Value = 0;
+        };
+
+        // Stand-ins for the types of a larger program, for lookups at different registry sizes.
+        template <size_t Index>
+        struct BenchmarkType { };
+
+        template <size_t Index>
+        void RegisterBenchmarkType()
+        {
+            RTTI::Reflect<BenchmarkType<Index>>("BenchmarkType" + std::to_string(Index));
+        }
+
+        template <size_t... Indices>
+        void RegisterBenchmarkTypes(size_t beginIndex, size_t endIndex, std::index_sequence<Indices...>)
+        {
+            static constexpr void (*registrations[])() = { &RegisterBenchmarkType<Indices>... };
+
+            for (size_t i = beginIndex; i < endIndex; ++i)
+            {
+                registrations[i]();
+            }
+        }
+
+        // Types and members are registered incrementally, as the cases ask for larger counts. Registration is process wide, so this remembers how far it got.
+        size_t g_RegisteredTypeCount = 0;
+        size_t g_RegisteredMemberCount = 0;
+
+        void RegisterTypes(size_t typeCount)
+        {
+            if (typeCount > g_RegisteredTypeCount)
+            {
+                RegisterBenchmarkTypes(g_RegisteredTypeCount, typeCount, std::make_index_sequence<RTTIBenchmark::MaxTypeCount>());
+                g_RegisteredTypeCount = typeCount;
+            }
+        }
+
+        void RegisterMembers(size_t memberCount)
+        {
+            for (; g_RegisteredMemberCount < memberCount; ++g_RegisteredMemberCount)
+            {
+                RTTI::Reflect<BenchmarkMembers>("BenchmarkMembers")
+                    .AddDataMember(&BenchmarkMembers::m_Value, "Member" + std::to_string(g_RegisteredMemberCount));
+            }
+        }
+
+        void RegisterBenchmarkTypes()
+        {
+            static bool isRegistered = false;
+            if (isRegistered)
+            {
+                return;
+            }
+
+            RTTI::Reflect<BenchmarkAccumulator>("BenchmarkAccumulator")
+                .AddMemberFunction(&BenchmarkAccumulator::Accumulate, "Accumulate");
+
+            RTTI::Reflect<BenchmarkVector>("BenchmarkVector")
+                .AddConstructor<>()
+                .AddConstructor<float, float, float>();
+
+            RTTI::Reflect<BenchmarkPayload>("BenchmarkPayload");
+
+            RTTI::Reflect<float>("float")
+                .AddConversion<double>();
+
+            isRegistered = true;
+        }
+
+        // The expected total after callCount calls of Accumulate(1.0, 2). Exact in double precision.
+        double GetExpectedTotal(size_t callCount)
+        {
+            return static_cast<double>(callCount) * 2.0;
+        }
+
+        // Times the operation settings.m_Iterations times. Each run performs settings.m_CallCount operations and returns whether they all produced the expected result.
+        RTTIBenchmarkResult Measure(const std::string& caseName, const RTTIBenchmarkSettings& settings, const std::function<bool()>& operation)
+        {
+            RTTIBenchmarkResult result;
+            result.m_Case = caseName;
+            result.m_OperationCount = settings.m_CallCount;
+            result.m_AllocationCount = SIZE_MAX;
+            result.m_IsVerified = true;
+
+            std::vector<double> runSeconds;
+            for (unsigned int i = 0; i < std::max(1u, settings.m_Iterations); ++i)
+            {
+                AllocationCounter allocationCounter;
+
+                const auto startTime = std::chrono::steady_clock::now();
+                const bool isVerified = operation();
+                runSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+                result.m_AllocationCount = std::min(result.m_AllocationCount, allocationCounter.GetCount());
+                result.m_IsVerified &= isVerified;
+            }
+
+            std::sort(runSeconds.begin(), runSeconds.end());
+            result.m_BestSeconds = runSeconds.front();
+            result.m_MedianSeconds = runSeconds[runSeconds.size() / 2];
+
+            std::printf("%-36s | %10zu Ops | Best %9.2f ms | Median %9.2f ms | %8.2f ns/op | %6.2f allocs/op | %s\n", caseName.c_str(), result.m_OperationCount,
+                        result.m_BestSeconds * 1000.0, result.m_MedianSeconds * 1000.0, result.GetNanosecondsPerOperation(), result.GetAllocationsPerOperation(),
+                        result.m_IsVerified ? "Verified" : "MISMATCH");
+
+            return result;
+        }
+
+        void MeasureInvocation(const RTTIBenchmarkSettings& settings, std::vector<RTTIBenchmarkResult>& results)
+        {
+            BenchmarkAccumulator accumulator;
+            const RTTI::Function* accumulate = RTTI::GetType<BenchmarkAccumulator>()->GetMemberFunction("Accumulate");
+            const size_t callCount = settings.m_CallCount;
+
+            results.push_back(Measure("Direct", settings, [&]()
+            {
+                accumulator.Reset();
+
+                double value = 1.0;
+                int weight = 2;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    accumulator.Accumulate(value, weight);
+                }
+
+                return accumulator.GetTotal() == GetExpectedTotal(callCount);
+            }));
+
+            std::function<double(double, int)> function = [&accumulator](double value, int weight) { return accumulator.Accumulate(value, weight); };
+            results.push_back(Measure("std::function", settings, [&]()
+            {
+                accumulator.Reset();
+
+                double value = 1.0;
+                int weight = 2;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    function(value, weight);
+                }
+
+                return accumulator.GetTotal() == GetExpectedTotal(callCount);
+            }));
+
+            results.push_back(Measure("Reflected", settings, [&]()
+            {
+                accumulator.Reset();
+
+                double value = 1.0;
+                int weight = 2;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    accumulate->Invoke(accumulator, value, weight);
+                }
+
+                return accumulator.GetTotal() == GetExpectedTotal(callCount);
+            }));
+
+            results.push_back(Measure("Reflected (Converted)", settings, [&]()
+            {
+                accumulator.Reset();
+
+                float value = 1.0f;
+                int weight = 2;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    accumulate->Invoke(accumulator, value, weight);
+                }
+
+                return accumulator.GetTotal() == GetExpectedTotal(callCount);
+            }));
+
+            results.push_back(Measure("Reflected (Any Vector)", settings, [&]()
+            {
+                accumulator.Reset();
+
+                std::vector<RTTI::Any> arguments{ RTTI::Any(1.0), RTTI::Any(2) };
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    accumulate->Invoke(accumulator, arguments);
+                }
+
+                return accumulator.GetTotal() == GetExpectedTotal(callCount);
+            }));
+        }
+
+        void MeasureLookups(const RTTIBenchmarkSettings& settings, std::vector<RTTIBenchmarkResult>& results)
+        {
+            const size_t callCount = settings.m_CallCount;
+
+            for (size_t typeCount : settings.m_TypeCounts)
+            {
+                typeCount = std::min(std::max<size_t>(typeCount, 1), RTTIBenchmark::MaxTypeCount);
+                RegisterTypes(typeCount);
+
+                // Lookups cycle through the first typeCount types. Names are built up front so that only the lookup is timed.
+                std::vector<std::string> names;
+                std::vector<RTTI::HashedName> hashedNames;
+                std::vector<const RTTI::TypeDescriptor*> expectedTypes;
+                for (size_t i = 0; i < typeCount; ++i)
+                {
+                    names.push_back("BenchmarkType" + std::to_string(i));
+                    expectedTypes.push_back(RTTI::GetType(names.back()));
+                }
+
+                for (const std::string& name : names)
+                {
+                    hashedNames.emplace_back(name);
+                }
+
+                const std::string countSuffix = " [" + std::to_string(typeCount) + " Types]";
+
+                results.push_back(Measure("GetType(Name)" + countSuffix, settings, [&]()
+                {
+                    bool isVerified = true;
+                    for (size_t i = 0; i < callCount; ++i)
+                    {
+                        const size_t index = i % typeCount;
+                        isVerified &= RTTI::GetType(std::string_view(names[index])) == expectedTypes[index];
+                    }
+
+                    return isVerified && expectedTypes[0];
+                }));
+
+                results.push_back(Measure("GetType(HashedName)" + countSuffix, settings, [&]()
+                {
+                    bool isVerified = true;
+                    for (size_t i = 0; i < callCount; ++i)
+                    {
+                        const size_t index = i % typeCount;
+                        isVerified &= RTTI::GetType(hashedNames[index]) == expectedTypes[index];
+                    }
+
+                    return isVerified && expectedTypes[0];
+                }));
+            }
+
+            for (size_t memberCount : settings.m_MemberCounts)
+            {
+                memberCount = std::max<size_t>(memberCount, 1);
+                RegisterMembers(memberCount);
+
+                const RTTI::TypeDescriptor* membersType = RTTI::GetType<BenchmarkMembers>();
+
+                std::vector<std::string> names;
+                std::vector<const RTTI::DataMember*> expectedMembers;
+                for (size_t i = 0; i < memberCount; ++i)
+                {
+                    names.push_back("Member" + std::to_string(i));
+                    expectedMembers.push_back(membersType->GetDataMember(names.back()));
+                }
+
+                results.push_back(Measure("GetDataMember(Name) [" + std::to_string(memberCount) + " Members]", settings, [&]()
+                {
+                    bool isVerified = true;
+                    for (size_t i = 0; i < callCount; ++i)
+                    {
+                        const size_t index = i % memberCount;
+                        isVerified &= membersType->GetDataMember(std::string_view(names[index])) == expectedMembers[index];
+                    }
+
+                    return isVerified && expectedMembers[0];
+                }));
+            }
+        }
+
+        void MeasureConstruction(const RTTIBenchmarkSettings& settings, std::vector<RTTIBenchmarkResult>& results)
+        {
+            const RTTI::TypeDescriptor* vectorType = RTTI::GetType<BenchmarkVector>();
+            const RTTI::Constructor* defaultConstructor = vectorType->GetConstructor<>();
+            const RTTI::Constructor* valueConstructor = vectorType->GetConstructor<float, float, float>();
+            const size_t callCount = settings.m_CallCount;
+
+            results.push_back(Measure("NewInstance()", settings, [&]()
+            {
+                bool isVerified = true;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any instance = defaultConstructor->NewInstance();
+                    const BenchmarkVector* vector = instance.TryCast<BenchmarkVector>();
+                    isVerified &= vector && vector->m_X == 0.0f;
+                }
+
+                return isVerified;
+            }));
+
+            results.push_back(Measure("NewInstance(float, float, float)", settings, [&]()
+            {
+                bool isVerified = true;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any instance = valueConstructor->NewInstance(1.0f, 2.0f, 3.0f);
+                    const BenchmarkVector* vector = instance.TryCast<BenchmarkVector>();
+                    isVerified &= vector && vector->m_Z == 3.0f;
+                }
+
+                return isVerified;
+            }));
+
+            // Batches from the type's object pool, constructed in place and returned to the pool.
+            RTTI::ObjectPool* objectPool = vectorType->GetObjectPool();
+            std::vector<void*> instances(ConstructionBatchSize);
+
+            results.push_back(Measure("NewInstances(float, float, float)", settings, [&]()
+            {
+                bool isVerified = true;
+                for (size_t i = 0; i < callCount; i += ConstructionBatchSize)
+                {
+                    const size_t batchSize = std::min(ConstructionBatchSize, callCount - i);
+                    isVerified &= valueConstructor->NewInstances(batchSize, *objectPool, instances.data(), 1.0f, 2.0f, 3.0f) == batchSize;
+                    isVerified &= static_cast<const BenchmarkVector*>(instances[batchSize - 1])->m_Z == 3.0f;
+                    objectPool->Delete(instances.data(), batchSize);
+                }
+
+                return isVerified;
+            }));
+        }
+
+        void MeasureAny(const RTTIBenchmarkSettings& settings, std::vector<RTTIBenchmarkResult>& results)
+        {
+            const size_t callCount = settings.m_CallCount;
+
+            RTTI::Any inlineValue(1.0);
+            RTTI::Any heapValue(BenchmarkPayload{});
+
+            results.push_back(Measure("Any Copy (Inline)", settings, [&]()
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any copy(inlineValue);
+                    total += *copy.TryCast<double>();
+                }
+
+                return total == static_cast<double>(callCount);
+            }));
+
+            results.push_back(Measure("Any Copy (Heap)", settings, [&]()
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any copy(heapValue);
+                    total += copy.TryCast<BenchmarkPayload>()->m_Values[0];
+                }
+
+                return total == static_cast<double>(callCount);
+            }));
+
+            // Each operation moves the value out and back again.
+            results.push_back(Measure("Any Move (Inline)", settings, [&]()
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any moved(std::move(inlineValue));
+                    total += *moved.TryCast<double>();
+                    inlineValue = std::move(moved);
+                }
+
+                return total == static_cast<double>(callCount);
+            }));
+
+            results.push_back(Measure("Any Move (Heap)", settings, [&]()
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any moved(std::move(heapValue));
+                    total += moved.TryCast<BenchmarkPayload>()->m_Values[0];
+                    heapValue = std::move(moved);
+                }
+
+                return total == static_cast<double>(callCount);
+            }));
+
+            RTTI::Any floatValue(1.0f);
+            results.push_back(Measure("TryConvert (float -> double)", settings, [&]()
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < callCount; ++i)
+                {
+                    RTTI::Any converted = floatValue.TryConvert<double>();
+                    const double* value = converted.TryCast<double>();
+                    total += value ? *value : 0.0;
+                }
+
+                return total == static_cast<double>(callCount);
+            }));
+        }
+    }
+
+    std::vector<RTTIBenchmarkResult> RTTIBenchmark::Run(const RTTIBenchmarkSettings& settings)
+    {
+        RegisterBenchmarkTypes();
+
+        std::printf("RTTI Benchmark | %zu Operations | %u Iterations\n", settings.m_CallCount, settings.m_Iterations);
+
+        std::vector<RTTIBenchmarkResult> results;
+        MeasureInvocation(settings, results);
+        MeasureLookups(settings, results);
+        MeasureConstruction(settings, results);
+        MeasureAny(settings, results);
+
+        if (!settings.m_ResultsPath.empty())
+        {
+            nlohmann::json report;
+            report["Benchmark"] = "RTTI";
+            report["CallCount"] = settings.m_CallCount;
+            report["Iterations"] = settings.m_Iterations;
+            report["TypeCounts"] = settings.m_TypeCounts;
+            report["MemberCounts"] = settings.m_MemberCounts;
+
+            for (const RTTIBenchmarkResult& result : results)
+            {
+                report["Results"].push_back(
+                {
+                    { "Case", result.m_Case },
+                    { "OperationCount", result.m_OperationCount },
+                    { "BestSeconds", result.m_BestSeconds },
+                    { "MedianSeconds", result.m_MedianSeconds },
+                    { "NanosecondsPerOperation", result.GetNanosecondsPerOperation() },
+                    { "AllocationsPerOperation", result.GetAllocationsPerOperation() },
+                    { "Verified", result.m_IsVerified }
+                });
+            }
+
+            std::ofstream resultsFile(settings.m_ResultsPath);
+            resultsFile << report.dump(4) << "\n";
+            std::printf("Results written to %s\n", settings.m_ResultsPath.c_str());
+        }
+
+        return results;
+    }
+
+    int RTTIBenchmark::RunFromCommandLine(int argc, char* argv[])
+    {
+        RTTIBenchmarkSettings settings;
+        if (argc > 0)
+        {
+            settings.m_CallCount = static_cast<size_t>(std::strtoull(argv[0], nullptr, 10));
+        }
+
+        if (argc > 1)
+        {
+            settings.m_Iterations = static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10));
+        }
+
+        if (argc > 2)
+        {
+            settings.m_ResultsPath = argv[2];
+        }
+
+        const std::vector<RTTIBenchmarkResult> results = Run(settings);
+        const bool isAllVerified = std::all_of(results.begin(), results.end(), [](const RTTIBenchmarkResult& result) { return result.m_IsVerified; });
+
+        return isAllVerified ? 0 : 1;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+    struct RTTIBenchmarkSettings
+    {
+        size_t m_CallCount = 1000000;                           // Operations per timed run.
+        unsigned int m_Iterations = 5;                          // Each case is timed this many times. The best and median runs are reported.
+        std::vector<size_t> m_TypeCounts = { 8, 64, 256 };      // Registered type counts to time name lookups at. At most MaxTypeCount.
+        std::vector<size_t> m_MemberCounts = { 4, 32, 256 };    // Data member counts to time member lookups at.
+        std::string m_ResultsPath = "RTTIBenchmark.json";       // Machine readable results. Empty skips writing them.
+    };
+
+    struct RTTIBenchmarkResult
+    {
+        std::string m_Case;
+        size_t m_OperationCount = 0;
+        double m_BestSeconds = 0.0;
+        double m_MedianSeconds = 0.0;
+        size_t m_AllocationCount = 0;   // Fewest allocations made by a run.
+        bool m_IsVerified = false;      // Every operation produced the expected result.
+
+        double GetNanosecondsPerOperation() const { return m_OperationCount > 0 ? (m_BestSeconds * 1e9) / m_OperationCount : 0.0; }
+        double GetAllocationsPerOperation() const { return m_OperationCount > 0 ? static_cast<double>(m_AllocationCount) / m_OperationCount : 0.0; }
+    };
+
+    /*
+        Measures the cost of the reflection system's operations, in time and allocations per operation:
+
+        - Invocation: a reflected member function call against a direct call and a std::function wrapping the same call. Reflected calls are timed
+          with arguments that match the parameters exactly, with an argument that has to go through a registered conversion, and through the
+          std::vector<Any> overload of Function::Invoke.
+        - Lookup: GetType by name and by precomputed HashedName with each of the type counts registered, and GetDataMember with each of the member counts.
+        - Construction: Constructor::NewInstance with and without arguments, and Constructor::NewInstances in batches from the type's object pool.
+        - Any: copies and moves of values stored inline and on the heap, and TryConvert through a registered conversion.
+    */
+    class RTTIBenchmark
+    {
+    public:
+        static constexpr size_t MaxTypeCount = 256;  // Benchmark types are distinct C++ types, so their number is fixed at compile time.
+
+        static std::vector<RTTIBenchmarkResult> Run(const RTTIBenchmarkSettings& settings);
+
+        // Usage: benchmark-rtti [callCount] [iterations] [resultsPath]. Returns the process exit code.
+        static int RunFromCommandLine(int argc, char* argv[]);
+    };
+}
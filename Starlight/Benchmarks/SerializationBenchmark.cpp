@@ -0,0 +1,333 @@
+#include "SerializationBenchmark.h"
+#include "../Serializations/Serializers/YAMLSerializer.h"
+#include "../Serializations/Serializers/BinarySerializer.h"
+#include <json/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+
+namespace Benchmarks
+{
+    namespace
+    {
+        enum class SyntheticFieldType
+        {
+            Bool,
+            Int,
+            UInt32,
+            Float,
+            Double,
+            String
+        };
+
+        struct SyntheticField
+        {
+            std::string m_KeyName;
+            SyntheticFieldType m_Type = SyntheticFieldType::Int;
+            bool m_Bool = false;
+            int m_Int = 0;
+            uint32_t m_UInt32 = 0;
+            float m_Float = 0.0f;
+            double m_Double = 0.0;
+            std::string m_String;
+        };
+
+        std::vector<SyntheticField> GenerateScene(const SerializationBenchmarkSettings& settings)
+        {
+            std::mt19937 randomEngine(12345); // Fixed seed so that runs are comparable.
+            std::uniform_real_distribution<float> floatDistribution(-1000.0f, 1000.0f);
+            std::uniform_int_distribution<int> intDistribution(0, 100000);
+
+            std::vector<SyntheticField> scene;
+            scene.reserve(settings.m_EntityCount * (15 + settings.m_ArrayLength));
+
+            auto addField = [&scene](std::string keyName, SyntheticFieldType fieldType) -> SyntheticField&
+            {
+                SyntheticField& field = scene.emplace_back();
+                field.m_KeyName = std::move(keyName);
+                field.m_Type = fieldType;
+                return field;
+            };
+
+            static const char* vectorComponents[] = { "X", "Y", "Z", "W" };
+            const struct { const char* m_Name; size_t m_Components; } vectorFields[] = { { "Position", 3 }, { "Rotation", 4 }, { "Scale", 3 } };
+
+            for (size_t entity = 0; entity < settings.m_EntityCount; ++entity)
+            {
+                const std::string prefix = "Entity_" + std::to_string(entity) + "_";
+
+                // Scalars
+                addField(prefix + "ID", SyntheticFieldType::UInt32).m_UInt32 = static_cast<uint32_t>(entity);
+                addField(prefix + "Name", SyntheticFieldType::String).m_String = "Entity " + std::to_string(entity);
+                addField(prefix + "Active", SyntheticFieldType::Bool).m_Bool = (entity % 3) != 0;
+                addField(prefix + "Health", SyntheticFieldType::Int).m_Int = intDistribution(randomEngine);
+                addField(prefix + "Mass", SyntheticFieldType::Double).m_Double = floatDistribution(randomEngine) * 0.001;
+
+                // Vectors
+                for (const auto& vectorField : vectorFields)
+                {
+                    for (size_t component = 0; component < vectorField.m_Components; ++component)
+                    {
+                        addField(prefix + vectorField.m_Name + "_" + vectorComponents[component], SyntheticFieldType::Float).m_Float = floatDistribution(randomEngine);
+                    }
+                }
+
+                // Arrays
+                for (size_t element = 0; element < settings.m_ArrayLength; ++element)
+                {
+                    addField(prefix + "Weights_" + std::to_string(element), SyntheticFieldType::Float).m_Float = floatDistribution(randomEngine);
+                }
+            }
+
+            return scene;
+        }
+
+        // Writes through the public SerializerCore interface, as engine code would.
+        void WriteScene(SerializerCore& serializer, const std::vector<SyntheticField>& scene)
+        {
+            serializer.BeginSerialization();
+
+            for (const SyntheticField& field : scene)
+            {
+                switch (field.m_Type)
+                {
+                case SyntheticFieldType::Bool:   { bool value = field.m_Bool;         serializer.Write(field.m_KeyName, value); break; }
+                case SyntheticFieldType::Int:    { int value = field.m_Int;           serializer.Write(field.m_KeyName, value); break; }
+                case SyntheticFieldType::UInt32: { uint32_t value = field.m_UInt32;   serializer.Write(field.m_KeyName, value); break; }
+                case SyntheticFieldType::Float:  { float value = field.m_Float;       serializer.Write(field.m_KeyName, value); break; }
+                case SyntheticFieldType::Double: { double value = field.m_Double;     serializer.Write(field.m_KeyName, value); break; }
+                case SyntheticFieldType::String: serializer.Write(field.m_KeyName, field.m_String); break;
+                }
+            }
+
+            serializer.EndSerialization();
+        }
+
+        // Reads every field back by key. Returns true if all values round tripped.
+        bool ReadScene(SerializerCore& serializer, const std::vector<SyntheticField>& scene)
+        {
+            serializer.BeginDeserialization();
+
+            bool isMatching = serializer.IsVersionVerified();
+            for (const SyntheticField& field : scene)
+            {
+                switch (field.m_Type)
+                {
+                case SyntheticFieldType::Bool:   { bool value = false;        serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_Bool;   break; }
+                case SyntheticFieldType::Int:    { int value = 0;             serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_Int;    break; }
+                case SyntheticFieldType::UInt32: { uint32_t value = 0;        serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_UInt32; break; }
+                case SyntheticFieldType::Float:  { float value = 0.0f;        serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_Float;  break; }
+                case SyntheticFieldType::Double: { double value = 0.0;        serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_Double; break; }
+                case SyntheticFieldType::String: { std::string value;         serializer.Read(field.m_KeyName, &value); isMatching &= value == field.m_String; break; }
+                }
+            }
+
+            serializer.EndDeserialization();
+
+            return isMatching;
+        }
+
+        void WriteSceneJSON(const std::string& filePath, const std::vector<SyntheticField>& scene)
+        {
+            nlohmann::json document;
+            document["Version_Main"] = 1;
+            document["Version_Patch"] = 0;
+            document["Target_Type"] = "Scene";
+
+            for (const SyntheticField& field : scene)
+            {
+                switch (field.m_Type)
+                {
+                case SyntheticFieldType::Bool:   document[field.m_KeyName] = field.m_Bool;   break;
+                case SyntheticFieldType::Int:    document[field.m_KeyName] = field.m_Int;    break;
+                case SyntheticFieldType::UInt32: document[field.m_KeyName] = field.m_UInt32; break;
+                case SyntheticFieldType::Float:  document[field.m_KeyName] = field.m_Float;  break;
+                case SyntheticFieldType::Double: document[field.m_KeyName] = field.m_Double; break;
+                case SyntheticFieldType::String: document[field.m_KeyName] = field.m_String; break;
+                }
+            }
+
+            std::ofstream outputFile(filePath);
+            outputFile << document.dump(4);
+        }
+
+        bool ReadSceneJSON(const std::string& filePath, const std::vector<SyntheticField>& scene)
+        {
+            std::ifstream inputFile(filePath);
+            const nlohmann::json document = nlohmann::json::parse(inputFile, nullptr, false);
+            if (document.is_discarded())
+            {
+                return false;
+            }
+
+            bool isMatching = true;
+            for (const SyntheticField& field : scene)
+            {
+                const nlohmann::json& value = document.at(field.m_KeyName);
+
+                switch (field.m_Type)
+                {
+                case SyntheticFieldType::Bool:   isMatching &= value.get<bool>() == field.m_Bool;               break;
+                case SyntheticFieldType::Int:    isMatching &= value.get<int>() == field.m_Int;                 break;
+                case SyntheticFieldType::UInt32: isMatching &= value.get<uint32_t>() == field.m_UInt32;         break;
+                case SyntheticFieldType::Float:  isMatching &= value.get<float>() == field.m_Float;             break;
+                case SyntheticFieldType::Double: isMatching &= value.get<double>() == field.m_Double;           break;
+                case SyntheticFieldType::String: isMatching &= value.get_ref<const std::string&>() == field.m_String; break;
+                }
+            }
+
+            return isMatching;
+        }
+
+        // Times the operation settings.m_Iterations times. The result's verification holds only if every run verified.
+        SerializationBenchmarkResult Measure(const std::string& backendName, const std::string& operationName, const std::string& filePath, size_t fieldCount, unsigned int iterations, const std::function<bool()>& operation)
+        {
+            SerializationBenchmarkResult result;
+            result.m_Backend = backendName;
+            result.m_Operation = operationName;
+            result.m_FieldCount = fieldCount;
+            result.m_IsVerified = true;
+
+            std::vector<double> runSeconds;
+            for (unsigned int i = 0; i < std::max(1u, iterations); ++i)
+            {
+                const auto startTime = std::chrono::steady_clock::now();
+                result.m_IsVerified &= operation();
+                runSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+            }
+
+            std::sort(runSeconds.begin(), runSeconds.end());
+            result.m_BestSeconds = runSeconds.front();
+            result.m_MedianSeconds = runSeconds[runSeconds.size() / 2];
+
+            std::error_code errorCode;
+            result.m_FileBytes = static_cast<size_t>(std::filesystem::file_size(filePath, errorCode));
+
+            std::printf("%-8s %-6s | %9zu Fields | %8.2f MB | Best %9.2f ms | Median %9.2f ms | %8.2f MB/s | %12.0f Fields/s | %s\n", backendName.c_str(), operationName.c_str(), fieldCount,
+                        result.m_FileBytes / (1024.0 * 1024.0), result.m_BestSeconds * 1000.0, result.m_MedianSeconds * 1000.0, result.GetMegabytesPerSecond(), result.GetFieldsPerSecond(),
+                        result.m_IsVerified ? "Verified" : "MISMATCH");
+
+            return result;
+        }
+    }
+
+    std::vector<SerializationBenchmarkResult> SerializationBenchmark::Run(const SerializationBenchmarkSettings& settings)
+    {
+        const std::vector<SyntheticField> scene = GenerateScene(settings);
+        const std::filesystem::path workingDirectory = settings.m_WorkingDirectory.empty() ? std::filesystem::current_path() : std::filesystem::path(settings.m_WorkingDirectory);
+
+        const std::string yamlPath = (workingDirectory / "SerializationBenchmark_YAML.starlight").string();
+        const std::string binaryPath = (workingDirectory / "SerializationBenchmark_Binary.starlight").string();
+        const std::string jsonPath = (workingDirectory / "SerializationBenchmark_JSON.json").string();
+
+        std::printf("Serialization Benchmark | %zu Entities | %zu Fields | %u Iterations\n", settings.m_EntityCount, scene.size(), settings.m_Iterations);
+
+        std::vector<SerializationBenchmarkResult> results;
+
+        // YAML
+        results.push_back(Measure("YAML", "Write", yamlPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            YAMLSerializer serializer(Serialization_Target::Serialization_Target_Scene, yamlPath);
+            serializer.SetVerbose(false);
+            serializer.EnableStreaming();
+            WriteScene(serializer, scene);
+            return true;
+        }));
+
+        results.push_back(Measure("YAML", "Read", yamlPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            YAMLSerializer serializer(Serialization_Target::Serialization_Target_Scene, yamlPath);
+            serializer.SetVerbose(false);
+            return ReadScene(serializer, scene);
+        }));
+
+        // Binary
+        results.push_back(Measure("Binary", "Write", binaryPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            BinarySerializer serializer(Serialization_Target::Serialization_Target_Scene, binaryPath);
+            serializer.SetVerbose(false);
+            WriteScene(serializer, scene);
+            return true;
+        }));
+
+        results.push_back(Measure("Binary", "Read", binaryPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            BinarySerializer serializer(Serialization_Target::Serialization_Target_Scene, binaryPath);
+            serializer.SetVerbose(false);
+            return ReadScene(serializer, scene);
+        }));
+
+        // JSON
+        results.push_back(Measure("JSON", "Write", jsonPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            WriteSceneJSON(jsonPath, scene);
+            return true;
+        }));
+
+        results.push_back(Measure("JSON", "Read", jsonPath, scene.size(), settings.m_Iterations, [&]()
+        {
+            return ReadSceneJSON(jsonPath, scene);
+        }));
+
+        if (!settings.m_ResultsPath.empty())
+        {
+            nlohmann::json report;
+            report["Benchmark"] = "Serialization";
+            report["EntityCount"] = settings.m_EntityCount;
+            report["ArrayLength"] = settings.m_ArrayLength;
+            report["FieldCount"] = scene.size();
+            report["Iterations"] = settings.m_Iterations;
+
+            for (const SerializationBenchmarkResult& result : results)
+            {
+                report["Results"].push_back(
+                {
+                    { "Backend", result.m_Backend },
+                    { "Operation", result.m_Operation },
+                    { "FieldCount", result.m_FieldCount },
+                    { "FileBytes", result.m_FileBytes },
+                    { "BestSeconds", result.m_BestSeconds },
+                    { "MedianSeconds", result.m_MedianSeconds },
+                    { "MegabytesPerSecond", result.GetMegabytesPerSecond() },
+                    { "FieldsPerSecond", result.GetFieldsPerSecond() },
+                    { "Verified", result.m_IsVerified }
+                });
+            }
+
+            std::ofstream resultsFile(settings.m_ResultsPath);
+            resultsFile << report.dump(4) << "\n";
+            std::printf("Results written to %s\n", settings.m_ResultsPath.c_str());
+        }
+
+        return results;
+    }
+
+    int SerializationBenchmark::RunFromCommandLine(int argc, char* argv[])
+    {
+        SerializationBenchmarkSettings settings;
+        if (argc > 0)
+        {
+            settings.m_EntityCount = static_cast<size_t>(std::strtoull(argv[0], nullptr, 10));
+        }
+
+        if (argc > 1)
+        {
+            settings.m_Iterations = static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10));
+        }
+
+        if (argc > 2)
+        {
+            settings.m_ResultsPath = argv[2];
+        }
+
+        const std::vector<SerializationBenchmarkResult> results = Run(settings);
+        const bool isAllVerified = std::all_of(results.begin(), results.end(), [](const SerializationBenchmarkResult& result) { return result.m_IsVerified; });
+
+        return isAllVerified ? 0 : 1;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+    struct SerializationBenchmarkSettings
+    {
+        size_t m_EntityCount = 10000;
+        size_t m_ArrayLength = 8;                                       // Elements in each entity's array field.
+        unsigned int m_Iterations = 5;                                  // Each backend and operation is timed this many times. The best and median runs are reported.
+        std::string m_WorkingDirectory = "";                            // Where the scene files are written. Empty uses the current directory.
+        std::string m_ResultsPath = "SerializationBenchmark.json";      // Machine readable results. Empty skips writing them.
+    };
+
+    struct SerializationBenchmarkResult
+    {
+        std::string m_Backend;
+        std::string m_Operation;        // "Write" or "Read".
+        size_t m_FieldCount = 0;
+        size_t m_FileBytes = 0;
+        double m_BestSeconds = 0.0;
+        double m_MedianSeconds = 0.0;
+        bool m_IsVerified = false;      // Read back values matched the synthetic scene.
+
+        double GetMegabytesPerSecond() const { return m_BestSeconds > 0.0 ? (m_FileBytes / (1024.0 * 1024.0)) / m_BestSeconds : 0.0; }
+        double GetFieldsPerSecond() const { return m_BestSeconds > 0.0 ? m_FieldCount / m_BestSeconds : 0.0; }
+    };
+
+    /*
+        Measures write and read throughput of the YAML, binary and JSON backends on a synthetic scene.
+
+        Entities carry scalars (ID, Name, Active, Health, Mass), vectors (Position, Rotation, Scale) and an array (Weights). The serializers only store top level
+        fields, so vectors and arrays are flattened into keyed fields (i.e. Entity_12_Position_X, Entity_12_Weights_3). Every backend stores the same fields so
+        that their numbers are comparable.
+    */
+    class SerializationBenchmark
+    {
+    public:
+        static std::vector<SerializationBenchmarkResult> Run(const SerializationBenchmarkSettings& settings);
+
+        // Usage: benchmark-serialization [entityCount] [iterations] [resultsPath]. Returns the process exit code.
+        static int RunFromCommandLine(int argc, char* argv[]);
+    };
+}
@@ -11,7 +11,7 @@ namespace Aurora
             return true;
         }
 
-        AURORA_ERROR(logLayer, debugCode, DebugCodeToString(debugCode));
+        AURORA_ERROR(logLayer, debugCode, "{}", DebugCodeToString(debugCode));
         return false;
     }
 }
@@ -19,12 +19,19 @@
 #include "Utilities/Trie.h"
 #include "Memory/MemoryRegistryMacros.h"
 #include "Debug/MemoryTracker.h"
+#include "Tools/AssetConverter.h"
+#include "Tools/LogDecoder.h"
+#ifdef STARLIGHT_BENCHMARKS
+#include "Benchmarks/SerializationBenchmark.h"
+#include "Benchmarks/RTTIBenchmark.h"
+#include "Benchmarks/LoggingBenchmark.h"
+#endif
 
 // Demo test bed for the tools within.
 
 using nlohmann::json;
 
-void Print(std::ostream& os, RTTI::Any object)
+void Print(std::ostream& os, RTTI::AnyRef object)
 {
 	const RTTI::TypeDescriptor* typeDescriptor = object.GetType();
 	os << typeDescriptor->GetName() << "::" << "\n";
@@ -33,13 +40,22 @@ void Print(std::ostream& os, RTTI::Any object)
 	{
 		const RTTI::TypeDescriptor* dataMemberType = dataMember->GetType();
 
-		if (const RTTI::Function* memberFunction = typeDescriptor->GetMemberFunction("print"); memberFunction)
+		// Members are walked in place. Only those behind a getter returning by value are copied.
+		RTTI::Any copiedMember;
+		RTTI::AnyRef member = dataMember->GetRef(object);
+		if (!member)
 		{
-			memberFunction->Invoke(RTTI::AnyRef(), dataMember->Get(object));
+			copiedMember = dataMember->Get(object);
+			member = copiedMember;
+		}
+
+		if (const RTTI::Function* memberFunction = dataMemberType->GetMemberFunction("print"); memberFunction)
+		{
+			memberFunction->Invoke(RTTI::AnyRef(), member);
 		}
 		else
 		{
-			Print(os, dataMember->Get(object));
+			Print(os, member);
 		}
 	}
 }
@@ -96,6 +112,23 @@ void DeserializePokemon(const json& json, Pokemon& pokemon)
 	pokemon = json;
 }
 
+// Pokemon is described at compile time rather than registered in SerializationTest. Its type descriptor is filled in on first use.
+template <>
+struct RTTI::StaticReflection<Pokemon>
+{
+	static constexpr HashedName Name{ "Pokemon" };
+	static inline const StaticRegistrar<Pokemon> Registrar;  // Makes GetType("Pokemon") work from startup.
+
+	static constexpr auto Constructors = std::make_tuple(StaticConstructor<>(), StaticConstructor<const std::string&>());
+
+	static constexpr auto DataMembers = std::make_tuple(StaticDataMember("PokemonName", &Pokemon::m_PokemonName),
+	                                                    StaticAccessor<&Pokemon::SetPokemonHealth, &Pokemon::GetPokemonHealth>("Health"));
+
+	static constexpr auto MemberFunctions = std::make_tuple(StaticFunction("Print", &Pokemon::Print),
+	                                                        StaticFunction("Serialize", &SerializePokemon),
+	                                                        StaticFunction("Deserialize", &DeserializePokemon));
+};
+
 void SerializationTest()
 {
 	// reflect types
@@ -115,16 +148,6 @@ void SerializationTest()
 	RTTI::Reflect<const char*>("cstring")
 		.AddConversion<std::string>();
 
-	// Register class with our reflection.
-	RTTI::Reflect<Pokemon>("Pokemon")
-		.AddConstructor<>()
-		.AddConstructor<const std::string&>()
-		.AddDataMember(&Pokemon::m_PokemonName, "PokemonName")
-		.AddDataMember<&Pokemon::SetPokemonHealth, &Pokemon::GetPokemonHealth>("Health")
-		.AddMemberFunction(&Pokemon::Print, "Print")
-		.AddMemberFunction(&SerializePokemon, "Serialize")
-		.AddMemberFunction(&DeserializePokemon, "Deserialize");
-
 	auto pokemon = RTTI::GetType("Pokemon")->GetConstructor<const std::string&>()->NewInstance("Raichu");
 	RTTI::GetType("Pokemon")->GetMemberFunction("Print")->Invoke(pokemon, "This Pokemon Name Is");
 	RTTI::GetType("Pokemon")->GetDataMember("Health")->Set(pokemon, 500.0f);
@@ -167,8 +190,43 @@ public:
 
 };
 
-int main(int argc, int argv[])
+int main(int argc, char* argv[])
 {
+	// Tools
+	if (argc > 1 && std::string(argv[1]) == "convert")
+	{
+		return Tools::AssetConverter::RunFromCommandLine(argc - 2, argv + 2);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "decode-log")
+	{
+		return Tools::LogDecoder::RunFromCommandLine(argc - 2, argv + 2);
+	}
+
+	// Benchmarks. Only built into the Benchmark configuration, as their allocation counter replaces the global operator new.
+#ifdef STARLIGHT_BENCHMARKS
+	if (argc > 1 && std::string(argv[1]) == "benchmark-serialization")
+	{
+		return Benchmarks::SerializationBenchmark::RunFromCommandLine(argc - 2, argv + 2);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "benchmark-rtti")
+	{
+		return Benchmarks::RTTIBenchmark::RunFromCommandLine(argc - 2, argv + 2);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "benchmark-logging")
+	{
+		return Benchmarks::LoggingBenchmark::RunFromCommandLine(argc - 2, argv + 2);
+	}
+#else
+	if (argc > 1 && std::string(argv[1]).rfind("benchmark-", 0) == 0)
+	{
+		std::cout << "Benchmarks are only built into the Benchmark configuration.\n";
+		return 1;
+	}
+#endif
+
 	REGISTER_MEMORY_BLOCK(Memory::MemoryPoolType::MemoryPoolType_General, sizeof(uint32_t) * 60);
 	std::cout << Memory::MemoryPoolRegistry::GetInstance().GetMemoryPoolUsage(Memory::MemoryPoolType::MemoryPoolType_General) << "\n";
 
@@ -191,7 +249,7 @@ int main(int argc, int argv[])
 
 	Aurora::Logger::GetInstance().EnableBackbuffer();
 	AURORA_ERROR(Aurora::LogLayer::Engine, Aurora::DebugCode::AURORA_ERROR_INITIALIZATION_FAILURE, "Hello There!");
-	// AURORA_TEST("Hello {0} ya", 2);
+	AURORA_INFO(Aurora::LogLayer::Engine, "Hello {0} ya", 2);
 	Utilities::Seqlock<int> integer;
 	integer.Store(0);
 	auto testThread = std::thread([&]
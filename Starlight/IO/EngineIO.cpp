@@ -71,11 +71,31 @@ namespace IO
 
     std::vector<std::string> EngineIO::GetSupportedSceneFilesInDirectory(const std::string& filePath)
     {
-        return std::vector<std::string>();
+        std::vector<std::string> sceneFiles;
+
+        for (const auto& file : FileSystem::GetFilesInDirectory(filePath))
+        {
+            if (IsEngineSceneFile(file))
+            {
+                sceneFiles.emplace_back(file);
+            }
+        }
+
+        return sceneFiles;
     }
 
     std::vector<std::string> EngineIO::GetSupportedModelFilesInDirectory(const std::string& filePath)
     {
-        return std::vector<std::string>();
+        std::vector<std::string> modelFiles;
+
+        for (const auto& file : FileSystem::GetFilesInDirectory(filePath))
+        {
+            if (IsSupportedModelFile(file))
+            {
+                modelFiles.emplace_back(file);
+            }
+        }
+
+        return modelFiles;
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@ namespace IO
 {
     class EngineIO
     {
+    public:
         // Supported Files - Externals
         static bool IsSupportedImageFile(const std::string& filePath);
         static bool IsSupportedModelFile(const std::string& filePath);
@@ -0,0 +1,133 @@
+#include "AsyncLogBackend.h"
+#include <algorithm>
+
+namespace Aurora
+{
+    namespace
+    {
+        std::atomic<uint64_t> g_NextBackendID = 1;
+    }
+
+    AsyncLogBackend::AsyncLogBackend(size_t queueCapacity, RecordHandler recordHandler)
+        : m_BackendID(g_NextBackendID.fetch_add(1, std::memory_order_relaxed)), m_QueueCapacity(queueCapacity), m_RecordHandler(std::move(recordHandler))
+    {
+        m_Thread = std::thread([this]() { Run(); });
+    }
+
+    AsyncLogBackend::~AsyncLogBackend()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsStopping = true;
+        }
+
+        m_Condition.notify_all();
+        m_Thread.join();
+    }
+
+    void AsyncLogBackend::Flush()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        const uint64_t flushRequest = ++m_FlushRequests;
+        m_Condition.notify_all();
+        m_Condition.wait(lock, [&]() { return m_FlushesCompleted >= flushRequest; });
+    }
+
+    AsyncLogBackend::ThreadQueueCache::~ThreadQueueCache()
+    {
+        if (m_ThreadQueue)
+        {
+            m_ThreadQueue->m_IsRetired.store(true, std::memory_order_release);
+        }
+    }
+
+    AsyncLogBackend::ThreadQueueCache& AsyncLogBackend::GetThreadQueueCache()
+    {
+        thread_local ThreadQueueCache threadQueueCache;
+        return threadQueueCache;
+    }
+
+    void AsyncLogBackend::RegisterThreadQueue(ThreadQueueCache& threadQueueCache)
+    {
+        // A queue registered with an earlier backend is left for that backend to free.
+        if (threadQueueCache.m_ThreadQueue)
+        {
+            threadQueueCache.m_ThreadQueue->m_IsRetired.store(true, std::memory_order_release);
+        }
+
+        threadQueueCache.m_ThreadQueue = std::make_shared<ThreadQueue>(m_QueueCapacity);
+        threadQueueCache.m_BackendID = m_BackendID;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_PendingQueues.push_back(threadQueueCache.m_ThreadQueue);
+    }
+
+    void AsyncLogBackend::Run()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        for (;;)
+        {
+            m_Queues.insert(m_Queues.end(), m_PendingQueues.begin(), m_PendingQueues.end());
+            m_PendingQueues.clear();
+
+            const uint64_t flushRequests = m_FlushRequests;
+            const bool isStopping = m_IsStopping;
+
+            lock.unlock();
+
+            // Drain until a pass comes up empty, so that everything pushed before a flush or stop request was read is handled.
+            size_t handledCount = 0;
+            while (size_t drainedCount = DrainQueues())
+            {
+                handledCount += drainedCount;
+            }
+
+            lock.lock();
+
+            if (m_FlushesCompleted < flushRequests)
+            {
+                m_FlushesCompleted = flushRequests;
+                m_Condition.notify_all();
+            }
+
+            if (isStopping)
+            {
+                return;
+            }
+
+            if (handledCount == 0)
+            {
+                m_Condition.wait_for(lock, m_IdleInterval, [&]() { return m_IsStopping || m_FlushRequests != flushRequests || !m_PendingQueues.empty(); });
+            }
+        }
+    }
+
+    size_t AsyncLogBackend::DrainQueues()
+    {
+        size_t drainedCount = 0;
+
+        for (std::shared_ptr<ThreadQueue>& threadQueue : m_Queues)
+        {
+            // Read before draining, so that a queue is only freed after its last record has been handled.
+            const bool isRetired = threadQueue->m_IsRetired.load(std::memory_order_acquire);
+
+            while (const LogRecord* logRecord = threadQueue->m_Queue.front())
+            {
+                m_RecordHandler(*logRecord);
+                threadQueue->m_Queue.pop();
+                ++drainedCount;
+            }
+
+            if (isRetired)
+            {
+                threadQueue.reset();
+            }
+        }
+
+        m_Queues.erase(std::remove(m_Queues.begin(), m_Queues.end(), nullptr), m_Queues.end());
+
+        return drainedCount;
+    }
+}
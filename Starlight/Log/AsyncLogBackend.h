@@ -0,0 +1,101 @@
+#pragma once
+#include "LogRecord.h"
+#include "../Utilities/SPSCQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aurora
+{
+    /*
+        Moves formatting and output off the threads that log. Each logging thread gets its own single producer, single consumer queue of
+        LogRecords, registered on its first push, so pushes never contend with each other. A background thread drains the queues and hands
+        each record to the handler.
+
+        A full queue makes its thread wait for the backend rather than drop records. Records from one thread are handled in order. Records
+        from different threads are not ordered with respect to each other. Destroying the backend handles everything pushed before it.
+    */
+    class AsyncLogBackend
+    {
+    public:
+        using RecordHandler = std::function<void(const LogRecord&)>;
+
+        AsyncLogBackend(size_t queueCapacity, RecordHandler recordHandler);
+        ~AsyncLogBackend();
+
+        AsyncLogBackend(const AsyncLogBackend&) = delete;
+        AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+        template <typename... Args>
+        void Push(Args&&... args)
+        {
+            Utilities::SPSCQueue<LogRecord>& queue = GetThreadQueue();
+
+            while (!queue.try_emplace(args...))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // Blocks until every record pushed before the call has been handled.
+        void Flush();
+
+    private:
+        struct ThreadQueue
+        {
+            explicit ThreadQueue(size_t capacity) : m_Queue(capacity) { }
+
+            Utilities::SPSCQueue<LogRecord> m_Queue;
+            std::atomic<bool> m_IsRetired = false;  // Set when the owning thread exits. The backend frees the queue once it is drained.
+        };
+
+        // Each thread caches the queue it pushes to, tagged with the backend it belongs to.
+        struct ThreadQueueCache
+        {
+            ~ThreadQueueCache();
+
+            uint64_t m_BackendID = 0;
+            std::shared_ptr<ThreadQueue> m_ThreadQueue;
+        };
+
+        Utilities::SPSCQueue<LogRecord>& GetThreadQueue()
+        {
+            ThreadQueueCache& threadQueueCache = GetThreadQueueCache();
+            if (threadQueueCache.m_BackendID != m_BackendID)
+            {
+                RegisterThreadQueue(threadQueueCache);
+            }
+
+            return threadQueueCache.m_ThreadQueue->m_Queue;
+        }
+
+        static ThreadQueueCache& GetThreadQueueCache();
+        void RegisterThreadQueue(ThreadQueueCache& threadQueueCache);
+
+        void Run();
+        size_t DrainQueues();
+
+    private:
+        static constexpr std::chrono::milliseconds m_IdleInterval = std::chrono::milliseconds(1);  // How long the backend sleeps when it finds nothing to handle.
+
+        const uint64_t m_BackendID;
+        const size_t m_QueueCapacity;
+        RecordHandler m_RecordHandler;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::vector<std::shared_ptr<ThreadQueue>> m_PendingQueues;  // Registered, but not yet picked up by the backend thread.
+        uint64_t m_FlushRequests = 0;
+        uint64_t m_FlushesCompleted = 0;
+        bool m_IsStopping = false;
+
+        std::vector<std::shared_ptr<ThreadQueue>> m_Queues;  // Only touched by the backend thread.
+        std::thread m_Thread;
+    };
+}
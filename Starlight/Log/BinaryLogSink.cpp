@@ -0,0 +1,131 @@
+#include "BinaryLogSink.h"
+#include "LogTimestamp.h"
+#include <chrono>
+#include <iterator>
+
+namespace Aurora
+{
+    namespace
+    {
+        int64_t ToNanoseconds(LogTimestamp logTimestamp)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(LogClock::Clock::duration(logTimestamp)).count();
+        }
+    }
+
+    BinaryLogSink::~BinaryLogSink()
+    {
+        Close();
+    }
+
+    bool BinaryLogSink::Open(const std::string& filePath)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (m_File)
+        {
+            FlushBuffer();
+            std::fclose(m_File);
+        }
+
+        m_File = std::fopen(filePath.c_str(), "wb");
+        if (!m_File)
+        {
+            return false;
+        }
+
+        m_SiteIDs.clear();
+        m_Buffer.clear();
+        m_Buffer.reserve(BufferSize);
+
+        const LogTimestamp startTimestamp = LogClock::Now();
+        m_LastRecordTime = ToNanoseconds(startTimestamp);
+
+        LogBinaryWriter<fmt::memory_buffer> binaryWriter(m_Buffer);
+        m_Buffer.append(std::begin(LogBinaryMagic), std::end(LogBinaryMagic));
+        binaryWriter.WriteUInt32(LogBinaryVersion);
+        binaryWriter.WriteSignedVarint(std::chrono::duration_cast<std::chrono::nanoseconds>(LogClock::ToSystemTime(startTimestamp).time_since_epoch()).count());
+
+        return true;
+    }
+
+    void BinaryLogSink::Close()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (m_File)
+        {
+            FlushBuffer();
+            std::fclose(m_File);
+            m_File = nullptr;
+        }
+    }
+
+    void BinaryLogSink::Write(const LogRecord& logRecord)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (!m_File)
+        {
+            return;
+        }
+
+        // The arguments go first, as they decide how the message is rebuilt and so which site the record belongs to.
+        m_ArgumentBuffer.clear();
+        const LogBinaryMessage messageKind = logRecord.EncodeArguments(m_ArgumentBuffer);
+
+        LogBinaryWriter<fmt::memory_buffer> binaryWriter(m_Buffer);
+
+        const auto [siteIterator, isNewSite] = m_SiteIDs.try_emplace(SiteKey{ &logRecord.GetLogSite(), logRecord.GetLogMessage(), messageKind }, m_SiteIDs.size());
+        if (isNewSite)
+        {
+            const LogSite& logSite = logRecord.GetLogSite();
+
+            binaryWriter.WriteByte(static_cast<uint8_t>(LogBinaryEntry::Site));
+            binaryWriter.WriteVarint(siteIterator->second);
+            binaryWriter.WriteByte(static_cast<uint8_t>(messageKind));
+            binaryWriter.WriteString(logRecord.GetLogMessage());
+            binaryWriter.WriteString(logSite.m_FilePath);
+            binaryWriter.WriteString(logSite.m_FunctionName);
+            binaryWriter.WriteVarint(static_cast<uint64_t>(logSite.m_LineNumber));
+        }
+
+        // Records from different threads' queues arrive slightly out of order, so the time since the last record may be negative.
+        const int64_t recordTime = ToNanoseconds(logRecord.GetLogTime());
+
+        binaryWriter.WriteByte(static_cast<uint8_t>(LogBinaryEntry::Record));
+        binaryWriter.WriteVarint(siteIterator->second);
+        binaryWriter.WriteSignedVarint(recordTime - m_LastRecordTime);
+        binaryWriter.WriteByte(static_cast<uint8_t>(logRecord.GetLogLayer()));
+        binaryWriter.WriteByte(static_cast<uint8_t>(logRecord.GetLogLevel()));
+        binaryWriter.WriteVarint(static_cast<uint64_t>(logRecord.GetDebugCode()));
+        m_Buffer.append(m_ArgumentBuffer.data(), m_ArgumentBuffer.data() + m_ArgumentBuffer.size());
+
+        m_LastRecordTime = recordTime;
+
+        if (m_Buffer.size() >= BufferSize)
+        {
+            FlushBuffer();
+        }
+    }
+
+    void BinaryLogSink::Flush()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        if (m_File)
+        {
+            FlushBuffer();
+            std::fflush(m_File);
+        }
+    }
+
+    void BinaryLogSink::FlushBuffer()
+    {
+        if (m_Buffer.size() > 0)
+        {
+            std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File);
+            m_Buffer.clear();
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "LogBinaryFormat.h"
+#include "LogRecord.h"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <fmt/format.h>
+
+namespace Aurora
+{
+    /*
+        Writes records to a file in the binary layout of LogBinaryFormat.h. Messages are never formatted: each call site's format string is
+        written once, and its records after that are only the site ID, the time and the raw arguments. Tools::LogDecoder turns the file back
+        into text or JSON.
+
+        Entries are built in a buffer and written out once it holds BufferSize bytes, on Flush, or when the file is closed.
+    */
+    class BinaryLogSink
+    {
+    public:
+        static constexpr size_t BufferSize = 64 * 1024;
+
+        BinaryLogSink() = default;
+        ~BinaryLogSink();
+
+        BinaryLogSink(const BinaryLogSink&) = delete;
+        BinaryLogSink& operator=(const BinaryLogSink&) = delete;
+
+        // Starts a new file, replacing any there. Returns false if it couldn't be opened.
+        bool Open(const std::string& filePath);
+        void Close();
+        bool IsOpen() const { return m_File != nullptr; }
+
+        void Write(const LogRecord& logRecord);
+        void Flush();
+
+    private:
+        struct SiteKey
+        {
+            const LogSite* m_LogSite;
+            const char* m_LogMessage;
+            LogBinaryMessage m_MessageKind;
+
+            bool operator==(const SiteKey& otherKey) const { return m_LogSite == otherKey.m_LogSite && m_LogMessage == otherKey.m_LogMessage && m_MessageKind == otherKey.m_MessageKind; }
+        };
+
+        struct SiteKeyHash
+        {
+            size_t operator()(const SiteKey& siteKey) const
+            {
+                return std::hash<const void*>()(siteKey.m_LogSite) ^ (std::hash<const void*>()(siteKey.m_LogMessage) << 1) ^ static_cast<size_t>(siteKey.m_MessageKind);
+            }
+        };
+
+        void FlushBuffer();
+
+    private:
+        std::mutex m_Mutex;     // Uncontended in asynchronous mode, where only the backend thread writes.
+        std::FILE* m_File = nullptr;
+
+        fmt::memory_buffer m_Buffer;
+        fmt::memory_buffer m_ArgumentBuffer;
+
+        std::unordered_map<SiteKey, uint64_t, SiteKeyHash> m_SiteIDs;
+        int64_t m_LastRecordTime = 0;   // Steady clock nanoseconds, starting from when the file was opened.
+    };
+}
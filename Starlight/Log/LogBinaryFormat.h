@@ -0,0 +1,276 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Aurora
+{
+    /*
+        The layout of binary log files, as written by BinaryLogSink and read back by Tools::LogDecoder.
+
+        A file starts with LogBinaryMagic, the format version and the wall clock time of its start, in nanoseconds since the epoch. Entries follow,
+        each led by a LogBinaryEntry byte. A site entry is written the first time a call site logs, carrying its ID, how its message is rebuilt,
+        its format string, file, function and line, and is referred to by ID from then on. A record entry holds the site ID, the time since the previous record, the layer, level and
+        debug code, and the raw arguments, each led by a LogBinaryArgument byte.
+
+        Unsigned integers are LEB128 varints, signed ones zigzag encoded first, so small values take a byte. Strings are a varint length followed
+        by their characters. Floats and doubles are their 4 and 8 bytes, little endian.
+    */
+    inline constexpr char LogBinaryMagic[4] = { 'A', 'L', 'O', 'G' };
+    inline constexpr uint32_t LogBinaryVersion = 1;
+
+    enum class LogBinaryEntry : uint8_t
+    {
+        Site = 1,
+        Record = 2
+    };
+
+    // How a site's message becomes text.
+    enum class LogBinaryMessage : uint8_t
+    {
+        Formatted = 0,      // The format string, applied to the record's arguments.
+        Raw = 1,            // The format string as is, for C strings logged without arguments.
+        Preformatted = 2    // The record's single string argument, for arguments that have no binary encoding.
+    };
+
+    enum class LogBinaryArgument : uint8_t
+    {
+        Int = 0,
+        UInt = 1,
+        Double = 2,
+        Bool = 3,
+        Char = 4,
+        String = 5,
+        Float = 6
+    };
+
+    // Whether an argument of type T is written as is. Records with any other kind of argument are written preformatted.
+    template <typename T>
+    inline constexpr bool IsLogBinaryEncodable = std::is_arithmetic_v<T> || std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+    // Appends entries to a byte buffer. Buffer is anything with append(const char*, const char*), such as fmt::memory_buffer.
+    template <typename Buffer>
+    class LogBinaryWriter
+    {
+    public:
+        explicit LogBinaryWriter(Buffer& buffer) : m_Buffer(buffer) { }
+
+        void WriteByte(uint8_t value)
+        {
+            const char byte = static_cast<char>(value);
+            m_Buffer.append(&byte, &byte + 1);
+        }
+
+        void WriteUInt32(uint32_t value)
+        {
+            const char bytes[4] = { static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+            m_Buffer.append(bytes, bytes + 4);
+        }
+
+        void WriteVarint(uint64_t value)
+        {
+            char bytes[10];
+            size_t byteCount = 0;
+
+            while (value >= 0x80)
+            {
+                bytes[byteCount++] = static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+
+            bytes[byteCount++] = static_cast<char>(value);
+            m_Buffer.append(bytes, bytes + byteCount);
+        }
+
+        void WriteSignedVarint(int64_t value)
+        {
+            WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void WriteString(std::string_view value)
+        {
+            WriteVarint(value.size());
+            m_Buffer.append(value.data(), value.data() + value.size());
+        }
+
+        void WriteDouble(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            char bytes[8];
+            for (size_t byteIndex = 0; byteIndex < 8; ++byteIndex)
+            {
+                bytes[byteIndex] = static_cast<char>(bits >> (byteIndex * 8));
+            }
+
+            m_Buffer.append(bytes, bytes + 8);
+        }
+
+        void WriteFloat(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            WriteUInt32(bits);
+        }
+
+        template <typename T>
+        void WriteArgument(const T& value)
+        {
+            static_assert(IsLogBinaryEncodable<T>, "Only encodable arguments can be written.");
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::Bool));
+                WriteByte(value ? 1 : 0);
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::Char));
+                WriteByte(static_cast<uint8_t>(value));
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::Float));
+                WriteFloat(value);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::Double));
+                WriteDouble(static_cast<double>(value));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::Int));
+                WriteSignedVarint(static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::UInt));
+                WriteVarint(static_cast<uint64_t>(value));
+            }
+            else
+            {
+                WriteByte(static_cast<uint8_t>(LogBinaryArgument::String));
+                WriteString(value);
+            }
+        }
+
+    private:
+        Buffer& m_Buffer;
+    };
+
+    // Reads entries back out of a file's contents. Reading past the end sets the error flag and returns zeroes, so callers check IsValid once per entry.
+    class LogBinaryReader
+    {
+    public:
+        explicit LogBinaryReader(std::string_view data) : m_Data(data) { }
+
+        bool IsAtEnd() const { return m_Position >= m_Data.size(); }
+        bool IsValid() const { return !m_HasError; }
+
+        uint8_t ReadByte()
+        {
+            if (m_Position >= m_Data.size())
+            {
+                m_HasError = true;
+                return 0;
+            }
+
+            return static_cast<uint8_t>(m_Data[m_Position++]);
+        }
+
+        uint64_t ReadVarint()
+        {
+            uint64_t value = 0;
+
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                const uint8_t byte = ReadByte();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+                if (!(byte & 0x80))
+                {
+                    return value;
+                }
+            }
+
+            m_HasError = true;
+            return 0;
+        }
+
+        int64_t ReadSignedVarint()
+        {
+            const uint64_t value = ReadVarint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        std::string_view ReadString()
+        {
+            const uint64_t length = ReadVarint();
+
+            if (m_HasError || length > m_Data.size() - m_Position)
+            {
+                m_HasError = true;
+                return std::string_view();
+            }
+
+            const std::string_view value = m_Data.substr(m_Position, static_cast<size_t>(length));
+            m_Position += static_cast<size_t>(length);
+            return value;
+        }
+
+        double ReadDouble()
+        {
+            uint64_t bits = 0;
+            for (size_t byteIndex = 0; byteIndex < 8; ++byteIndex)
+            {
+                bits |= static_cast<uint64_t>(ReadByte()) << (byteIndex * 8);
+            }
+
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        float ReadFloat()
+        {
+            const uint32_t bits = ReadUInt32();
+
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        uint32_t ReadUInt32()
+        {
+            uint32_t value = 0;
+            for (size_t byteIndex = 0; byteIndex < 4; ++byteIndex)
+            {
+                value |= static_cast<uint32_t>(ReadByte()) << (byteIndex * 8);
+            }
+
+            return value;
+        }
+
+        std::string_view ReadBytes(size_t byteCount)
+        {
+            if (byteCount > m_Data.size() - m_Position)
+            {
+                m_HasError = true;
+                return std::string_view();
+            }
+
+            const std::string_view value = m_Data.substr(m_Position, byteCount);
+            m_Position += byteCount;
+            return value;
+        }
+
+    private:
+        std::string_view m_Data;
+        size_t m_Position = 0;
+        bool m_HasError = false;
+    };
+}
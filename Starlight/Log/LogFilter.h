@@ -0,0 +1,78 @@
+#pragma once
+#include "LogClassification.h"
+#include <atomic>
+#include <cstdint>
+
+namespace Aurora
+{
+    /*
+        Which levels are logged for each layer, changeable at runtime from any thread. Every layer and level pair is one bit of a single atomic
+        mask, so checking a message is a relaxed load, a shift and a branch, cheap enough for the AURORA_* macros to do before evaluating any of
+        their arguments. Everything is enabled to begin with.
+    */
+    class LogFilter
+    {
+    public:
+        static constexpr int LayerCount = static_cast<int>(LogLayer::Unknown) + 1;
+        static constexpr int LevelCount = static_cast<int>(LogLevel::Unknown) + 1;
+
+        static_assert(LayerCount * LevelCount <= 64, "Every layer and level pair needs a bit in the mask.");
+
+        constexpr LogFilter() = default;
+
+        bool IsEnabled(LogLayer logLayer, LogLevel logLevel) const
+        {
+            return (m_EnabledMask.load(std::memory_order_relaxed) >> GetBitIndex(logLayer, logLevel)) & 1;
+        }
+
+        void SetEnabled(LogLayer logLayer, LogLevel logLevel, bool isEnabled)
+        {
+            const uint64_t bit = uint64_t(1) << GetBitIndex(logLayer, logLevel);
+
+            if (isEnabled)
+            {
+                m_EnabledMask.fetch_or(bit, std::memory_order_relaxed);
+            }
+            else
+            {
+                m_EnabledMask.fetch_and(~bit, std::memory_order_relaxed);
+            }
+        }
+
+        // Logs the layer's messages at minimumLevel and above, and drops the rest.
+        void SetMinimumLevel(LogLayer logLayer, LogLevel minimumLevel)
+        {
+            const uint64_t layerMask = GetLayerMask(logLayer);
+            const uint64_t enabledMask = (GetAllLevelsMask() << static_cast<int>(minimumLevel)) & GetAllLevelsMask();
+            const uint64_t layerBits = enabledMask << (static_cast<int>(logLayer) * LevelCount);
+
+            uint64_t mask = m_EnabledMask.load(std::memory_order_relaxed);
+            while (!m_EnabledMask.compare_exchange_weak(mask, (mask & ~layerMask) | layerBits, std::memory_order_relaxed));
+        }
+
+        // The same for every layer.
+        void SetMinimumLevel(LogLevel minimumLevel)
+        {
+            for (int logLayer = 0; logLayer < LayerCount; ++logLayer)
+            {
+                SetMinimumLevel(static_cast<LogLayer>(logLayer), minimumLevel);
+            }
+        }
+
+        void EnableAll() { m_EnabledMask.store(GetAllMask(), std::memory_order_relaxed); }
+        void DisableAll() { m_EnabledMask.store(0, std::memory_order_relaxed); }
+
+    private:
+        static constexpr int GetBitIndex(LogLayer logLayer, LogLevel logLevel)
+        {
+            return static_cast<int>(logLayer) * LevelCount + static_cast<int>(logLevel);
+        }
+
+        static constexpr uint64_t GetAllLevelsMask() { return (uint64_t(1) << LevelCount) - 1; }
+        static constexpr uint64_t GetLayerMask(LogLayer logLayer) { return GetAllLevelsMask() << (static_cast<int>(logLayer) * LevelCount); }
+        static constexpr uint64_t GetAllMask() { return (uint64_t(1) << (LayerCount * LevelCount)) - 1; }
+
+    private:
+        std::atomic<uint64_t> m_EnabledMask = GetAllMask();
+    };
+}
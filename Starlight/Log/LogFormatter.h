@@ -1,14 +1,16 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <iostream>
 
 namespace Aurora
 {
-    inline std::string LogFormatter_WithTimestamps(const LogPayload& logPackage)
+    // The time is passed in formatted, as the timestamp in the metadata is raw. See LogTimestampCache.
+    inline std::string LogFormatter_WithTimestamps(const LogPayload& logPackage, std::string_view logTime)
     {
-        return fmt::format("[{0}][{1}] {2} (Line {3}, {4}) \n", LogLevelToString(logPackage.m_LogLevel), logPackage.m_LogMetadata.m_LogTime, logPackage.m_LogMessage, logPackage.m_LogMetadata.m_LineNumber, logPackage.m_LogMetadata.m_FilePath);
+        return fmt::format("[{0}][{1}] {2} (Line {3}, {4}) \n", LogLevelToString(logPackage.m_LogLevel), logTime, logPackage.m_LogMessage, logPackage.m_LogMetadata.m_LineNumber, logPackage.m_LogMetadata.m_FilePath);
     }
 
     inline std::string LogFormatter_Complete(const LogPayload& logPackage)
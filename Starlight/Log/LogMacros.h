@@ -3,71 +3,58 @@
 #include "LogFormatter.h"
 
 #include <fmt/core.h>
+#include <fmt/compile.h>
 #include <fmt/format.h>
 
-namespace Aurora
-{
+/*
+    Logging macros. Format strings are fmt format strings, checked and compiled along with the call, so a mismatch between the string and the
+    arguments is a compile error. Arguments are captured by value, and formatted only when the message is output, which in asynchronous mode
+    happens on the logging backend's thread.
+
+    At runtime, messages are first checked against Logger::GetFilter(), and those it drops cost a load and a branch, with no arguments
+    evaluated. Levels below AURORA_MINIMUM_LOG_LEVEL (0 for Info up to 3 for Critical, as in LogLevel) are compiled out, arguments and all. Without
+    AURORA_DEBUG, every level is.
+*/
 #ifdef AURORA_DEBUG
 
-#define AURORA_TEST(...) Aurora::LogError(__VA_ARGS__);
+#ifndef AURORA_MINIMUM_LOG_LEVEL
+#define AURORA_MINIMUM_LOG_LEVEL 0
+#endif
 
-// #define AURORA_INFO(logLayer, logMessage)                 Aurora::Logger::GetInstance().LogMessageFinal(logLayer, logMessage, __FUNCTION__);
-#define AURORA_ERROR(logLayer, debugCode, logMessage)     Aurora::Logger::GetInstance().LogMessageError(logLayer, debugCode, logMessage, Aurora::LogMetadata(__FILE__, __FUNCSIG__, __LINE__));
-// #define AURORA_WARNING(logLayer, debugCode, logMessage)   Aurora::Logger::GetInstance().LogMessageWarning(logLayer, debugCode, logMessage);
-#define AURORA_TRACE(traceInfo) std::cout << "[TRACE] " #traceInfo " = [" << traceInfo << "]" << std::endl;
+#define AURORA_LOG(logLayer, logLevel, debugCode, formatString, ...)  do { const Aurora::LogLayer auroraLogLayer = (logLayer); if (Aurora::Logger::GetFilter().IsEnabled(auroraLogLayer, logLevel)) { static constexpr Aurora::LogSite auroraLogSite(__FILE__, __FUNCSIG__, __LINE__); Aurora::Logger::GetInstance().LogMessage(auroraLogSite, auroraLogLayer, logLevel, debugCode, FMT_COMPILE(formatString), ##__VA_ARGS__); } } while (0)
 
+#if AURORA_MINIMUM_LOG_LEVEL <= 0
+#define AURORA_INFO(logLayer, formatString, ...)                   AURORA_LOG(logLayer, Aurora::LogLevel::Info, Aurora::DebugCode::AURORA_SUCCESS, formatString, ##__VA_ARGS__)
 #else
-
-#define AURORA_INFO(logLayer, logMessage)
-#define AURORA_ERROR(logLayer, debugCode, logMessage)
-#define AURORA_WARNING(logLayer, debugCode, logMessage)
-
+#define AURORA_INFO(logLayer, formatString, ...)
 #endif
 
-    /*
-    template <typename FormatString, typename ...Args>
-    void Log_(LogMetadata logMetadata, LogLevel logLevel, const FormatString& fmt, const Args& ...args)
-    {
-        fmt::basic_memory_buffer<char, 250> buffer;
-        fmt::format_to(buffer, fmt, args...);
-        std::cout << fmt::string_view::basic_string_view(buffer.data(), buffer.size()).data();
-    }
+#if AURORA_MINIMUM_LOG_LEVEL <= 1
+#define AURORA_WARNING(logLayer, debugCode, formatString, ...)     AURORA_LOG(logLayer, Aurora::LogLevel::Warning, debugCode, formatString, ##__VA_ARGS__)
+#else
+#define AURORA_WARNING(logLayer, debugCode, formatString, ...)
+#endif
 
-    template <typename ...Args>
-    void Log(LogMetadata logMetadata, LogLevel logLevel, fmt::basic_string_view<char> fmt, const Args& ...args)
-    {
-        Log_(logMetadata, logLevel, fmt, args...);
-    }
+#if AURORA_MINIMUM_LOG_LEVEL <= 2
+#define AURORA_ERROR(logLayer, debugCode, formatString, ...)       AURORA_LOG(logLayer, Aurora::LogLevel::Error, debugCode, formatString, ##__VA_ARGS__)
+#else
+#define AURORA_ERROR(logLayer, debugCode, formatString, ...)
+#endif
 
-    // T cannot be statistically converted to string_view or wstring_view.
-    template <typename T>
-    void Log(LogMetadata logMetadata, LogLevel logLevel, const T& message)
-    {
-        Log(logMetadata, logLevel, "{}", message);
-    }
+#if AURORA_MINIMUM_LOG_LEVEL <= 3
+#define AURORA_CRITICAL(logLayer, debugCode, formatString, ...)    AURORA_LOG(logLayer, Aurora::LogLevel::Critical, debugCode, formatString, ##__VA_ARGS__)
+#else
+#define AURORA_CRITICAL(logLayer, debugCode, formatString, ...)
+#endif
 
-    template <typename T>
-    inline void Log(LogLevel logLevel, const T& message)
-    {
-        Log(LogMetadata(), logLevel, message);
-    }
+#define AURORA_TRACE(traceInfo) std::cout << "[TRACE] " #traceInfo " = [" << traceInfo << "]" << std::endl;
 
-    template <typename FormatString, typename ...Args>
-    inline void Log(LogLevel logLevel, const FormatString& formatString, const Args& ...args)
-    {
-        Log(LogMetadata(), logLevel, formatString, args...);
-    }
+#else
 
-    template <typename T>
-    inline void LogError(const T& message)
-    {
-        Log(LogLevel::Error, message);
-    }
+#define AURORA_LOG(logLayer, logLevel, debugCode, formatString, ...)
+#define AURORA_INFO(logLayer, formatString, ...)
+#define AURORA_WARNING(logLayer, debugCode, formatString, ...)
+#define AURORA_ERROR(logLayer, debugCode, formatString, ...)
+#define AURORA_CRITICAL(logLayer, debugCode, formatString, ...)
 
-    template <typename FormatString, typename ...Args>
-    inline void LogError(const FormatString& formatString, const Args& ...args)
-    {
-        Log(LogLevel::Error, formatString, args...);
-    }
-    */
-}
\ No newline at end of file
+#endif
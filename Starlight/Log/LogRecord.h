@@ -0,0 +1,283 @@
+#pragma once
+#include "LogBinaryFormat.h"
+#include "LogClassification.h"
+#include "LogStructures.h"
+#include "LogTimestamp.h"
+#include "../Debug/DebugCode.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <fmt/core.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+namespace Aurora
+{
+    /*
+        A log call as captured on the calling thread: the call site, the message (an fmt format string when there are arguments) and the
+        arguments themselves, stored by value. Nothing is formatted until FormatMessage is called, which for asynchronous logging happens on
+        the backend thread.
+
+        The message is either a compiled format string, from FMT_COMPILE, as the AURORA_* macros pass, or a plain C string. Compiled ones are
+        checked when the call is compiled and always formatted, so "{{" works with no arguments. C strings are parsed at runtime, and only
+        when there are arguments.
+
+        Records have a fixed size so that they can live in the slots of a queue. Arguments that don't fit in ArgumentCapacity are formatted
+        up front instead. C strings are copied, as the text they point to may not outlive the call. The message itself is not, so it must be a
+        string literal or otherwise live as long as the logger, which holds for every AURORA_* macro.
+    */
+    class LogRecord
+    {
+    public:
+        static constexpr size_t ArgumentCapacity = 64;
+
+        template <typename... Args>
+        LogRecord(const LogSite& logSite, LogLayer logLayer, LogLevel logLevel, DebugCode debugCode, LogTimestamp logTime, const char* logMessage, Args&&... args)
+            : m_LogSite(&logSite), m_LogMessage(logMessage), m_LogTime(logTime), m_LogLayer(logLayer), m_LogLevel(logLevel), m_DebugCode(debugCode)
+        {
+            using Arguments = std::tuple<CapturedType<Args>...>;
+
+            if constexpr (sizeof...(Args) == 0)
+            {
+                m_ManageArguments = nullptr;
+            }
+            else if constexpr (IsStoredInPlace<Arguments>)
+            {
+                new (m_Arguments) Arguments(CaptureArgument(std::forward<Args>(args))...);
+                m_ManageArguments = &ManageArguments<Arguments>;
+            }
+            else
+            {
+                new (m_Arguments) std::string(FormatArguments(logMessage, args...));
+                m_ManageArguments = &ManagePreformattedArguments;
+            }
+        }
+
+        template <typename FormatString, typename... Args, typename = std::enable_if_t<fmt::detail::is_compiled_string<FormatString>::value>>
+        LogRecord(const LogSite& logSite, LogLayer logLayer, LogLevel logLevel, DebugCode debugCode, LogTimestamp logTime, const FormatString& formatString, Args&&... args)
+            : m_LogSite(&logSite), m_LogMessage(fmt::string_view(formatString).data()), m_LogTime(logTime), m_LogLayer(logLayer), m_LogLevel(logLevel), m_DebugCode(debugCode)
+        {
+            using Arguments = std::tuple<CapturedType<Args>...>;
+
+            if constexpr (IsStoredInPlace<Arguments>)
+            {
+                new (m_Arguments) Arguments(CaptureArgument(std::forward<Args>(args))...);
+                m_ManageArguments = &ManageCompiledArguments<FormatString, Arguments>;
+            }
+            else
+            {
+                new (m_Arguments) std::string(fmt::format(formatString, args...));
+                m_ManageArguments = &ManagePreformattedArguments;
+            }
+        }
+
+        ~LogRecord()
+        {
+            if (m_ManageArguments)
+            {
+                m_ManageArguments(Operation::Destroy, const_cast<unsigned char*>(m_Arguments), nullptr, nullptr);
+            }
+        }
+
+        LogRecord(const LogRecord&) = delete;
+        LogRecord& operator=(const LogRecord&) = delete;
+
+        // Appends the formatted message. A message that fails to format is appended as is, followed by the reason.
+        void FormatMessage(fmt::memory_buffer& buffer) const
+        {
+            if (!m_ManageArguments)
+            {
+                buffer.append(fmt::string_view(m_LogMessage));
+                return;
+            }
+
+            const size_t messageStart = buffer.size();
+
+            try
+            {
+                m_ManageArguments(Operation::Format, const_cast<unsigned char*>(m_Arguments), m_LogMessage, &buffer);
+            }
+            catch (const fmt::format_error& formatError)
+            {
+                buffer.resize(messageStart);
+                fmt::format_to(std::back_inserter(buffer), "{} [Format Error: {}]", m_LogMessage, formatError.what());
+            }
+        }
+
+        /*
+            Appends the argument count and the arguments, as laid out in LogBinaryFormat.h, and returns how the message is to be rebuilt from them.
+            Records with an argument that has no binary encoding are formatted here and written as a single string.
+        */
+        LogBinaryMessage EncodeArguments(fmt::memory_buffer& buffer) const
+        {
+            if (!m_ManageArguments)
+            {
+                LogBinaryWriter<fmt::memory_buffer>(buffer).WriteVarint(0);
+                return LogBinaryMessage::Raw;
+            }
+
+            if (m_ManageArguments(Operation::Encode, const_cast<unsigned char*>(m_Arguments), m_LogMessage, &buffer))
+            {
+                return LogBinaryMessage::Formatted;
+            }
+
+            fmt::memory_buffer messageBuffer;
+            FormatMessage(messageBuffer);
+
+            LogBinaryWriter<fmt::memory_buffer> binaryWriter(buffer);
+            binaryWriter.WriteVarint(1);
+            binaryWriter.WriteArgument(std::string_view(messageBuffer.data(), messageBuffer.size()));
+
+            return LogBinaryMessage::Preformatted;
+        }
+
+        const LogSite& GetLogSite() const { return *m_LogSite; }
+        const char* GetLogMessage() const { return m_LogMessage; }
+        LogTimestamp GetLogTime() const { return m_LogTime; }
+        LogLayer GetLogLayer() const { return m_LogLayer; }
+        LogLevel GetLogLevel() const { return m_LogLevel; }
+        DebugCode GetDebugCode() const { return m_DebugCode; }
+
+    private:
+        enum class Operation
+        {
+            Format,
+            Encode,
+            Destroy
+        };
+
+        // Returns whether the operation was carried out, which only Encode may not be.
+        using ManageArgumentsFunction = bool (*)(Operation operation, void* arguments, const char* logMessage, fmt::memory_buffer* buffer);
+
+        // Pointers and views refer to the caller's strings, which may be gone by the time an asynchronous record is formatted, so they're copied.
+        template <typename T>
+        static constexpr bool IsBorrowedString = std::is_same_v<T, const char*> || std::is_same_v<T, char*> || std::is_same_v<T, std::string_view> || std::is_same_v<T, fmt::string_view>;
+
+        template <typename T>
+        using CapturedType = std::conditional_t<IsBorrowedString<std::decay_t<T>>, std::string, std::decay_t<T>>;
+
+        // std::string can't be constructed from fmt::string_view directly.
+        template <typename T>
+        static decltype(auto) CaptureArgument(T&& argument)
+        {
+            if constexpr (std::is_same_v<std::decay_t<T>, fmt::string_view>)
+            {
+                return std::string(argument.data(), argument.size());
+            }
+            else
+            {
+                return std::forward<T>(argument);
+            }
+        }
+
+        template <typename Arguments>
+        static constexpr bool IsStoredInPlace = sizeof(Arguments) <= ArgumentCapacity && alignof(Arguments) <= alignof(std::max_align_t);
+
+        template <typename... Args>
+        static std::string FormatArguments(const char* logMessage, const Args&... args)
+        {
+            try
+            {
+                return fmt::vformat(fmt::string_view(logMessage), fmt::make_format_args(args...));
+            }
+            catch (const fmt::format_error& formatError)
+            {
+                return fmt::format("{} [Format Error: {}]", logMessage, formatError.what());
+            }
+        }
+
+        template <typename... Types>
+        static bool EncodeCapturedArguments(const std::tuple<Types...>& capturedArguments, fmt::memory_buffer& buffer)
+        {
+            if constexpr ((IsLogBinaryEncodable<Types> && ...))
+            {
+                LogBinaryWriter<fmt::memory_buffer> binaryWriter(buffer);
+                binaryWriter.WriteVarint(sizeof...(Types));
+                std::apply([&](const auto&... values) { (binaryWriter.WriteArgument(values), ...); }, capturedArguments);
+
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template <typename Arguments>
+        static bool ManageArguments(Operation operation, void* arguments, const char* logMessage, fmt::memory_buffer* buffer)
+        {
+            Arguments& capturedArguments = *static_cast<Arguments*>(arguments);
+
+            if (operation == Operation::Format)
+            {
+                std::apply([&](const auto&... values) { fmt::vformat_to(std::back_inserter(*buffer), fmt::string_view(logMessage), fmt::make_format_args(values...)); }, capturedArguments);
+            }
+            else if (operation == Operation::Encode)
+            {
+                return EncodeCapturedArguments(capturedArguments, *buffer);
+            }
+            else
+            {
+                capturedArguments.~Arguments();
+            }
+
+            return true;
+        }
+
+        template <typename FormatString, typename Arguments>
+        static bool ManageCompiledArguments(Operation operation, void* arguments, const char*, fmt::memory_buffer* buffer)
+        {
+            Arguments& capturedArguments = *static_cast<Arguments*>(arguments);
+
+            if (operation == Operation::Format)
+            {
+                std::apply([&](const auto&... values) { fmt::format_to(std::back_inserter(*buffer), FormatString(), values...); }, capturedArguments);
+            }
+            else if (operation == Operation::Encode)
+            {
+                return EncodeCapturedArguments(capturedArguments, *buffer);
+            }
+            else
+            {
+                capturedArguments.~Arguments();
+            }
+
+            return true;
+        }
+
+        static bool ManagePreformattedArguments(Operation operation, void* arguments, const char*, fmt::memory_buffer* buffer)
+        {
+            std::string& message = *static_cast<std::string*>(arguments);
+
+            if (operation == Operation::Format)
+            {
+                buffer->append(fmt::string_view(message));
+            }
+            else if (operation == Operation::Encode)
+            {
+                return false;
+            }
+            else
+            {
+                message.~basic_string();
+            }
+
+            return true;
+        }
+
+    private:
+        const LogSite* m_LogSite;
+        const char* m_LogMessage;
+        LogTimestamp m_LogTime;
+        LogLayer m_LogLayer;
+        LogLevel m_LogLevel;
+        DebugCode m_DebugCode;
+        ManageArgumentsFunction m_ManageArguments;
+        alignas(std::max_align_t) unsigned char m_Arguments[ArgumentCapacity];
+    };
+}
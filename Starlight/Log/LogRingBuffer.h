@@ -0,0 +1,151 @@
+#pragma once
+#include "LogClassification.h"
+#include "LogTimestamp.h"
+#include "../Debug/DebugCode.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Aurora
+{
+    // A log message with its text stored apart, in whichever buffer holds the entry.
+    struct LogEntry
+    {
+        LogLayer m_LogLayer = LogLayer::Unknown;
+        LogLevel m_LogLevel = LogLevel::Unknown;
+        DebugCode m_DebugCode = DebugCode::AURORA_MAX_ENUM;
+        int m_LineNumber = 0;
+        const char* m_FilePath = "";    // Must be static, such as __FILE__.
+        LogTimestamp m_LogTime = 0;
+        uint32_t m_MessageOffset = 0;
+        uint32_t m_MessageLength = 0;
+    };
+
+    // A copy of a LogRingBuffer's entries, oldest first.
+    struct LogSnapshot
+    {
+        std::vector<LogEntry> m_Entries;
+        std::vector<char> m_Text;
+
+        std::string_view GetMessage(const LogEntry& logEntry) const { return std::string_view(m_Text.data() + logEntry.m_MessageOffset, logEntry.m_MessageLength); }
+    };
+
+    /*
+        Keeps the most recent entries in preallocated slots, overwriting the oldest once full. Each slot owns a fixed region of one text arena,
+        and messages longer than that are truncated, so appending never allocates.
+
+        Any number of threads may append at once. Appends claim a slot with a single atomic increment, and publish it through the slot's sequence
+        number, the same way as Utilities::Seqlock. Snapshots copy each slot and skip those written to during the copy, so they never block or
+        tear, but may miss entries being written as they are taken.
+    */
+    class LogRingBuffer
+    {
+    public:
+        LogRingBuffer(size_t capacity, size_t maxMessageLength)
+            : m_Capacity(std::max<size_t>(capacity, 1)), m_MaxMessageLength(maxMessageLength), m_Slots(new Slot[m_Capacity]), m_Arena(new char[m_Capacity * m_MaxMessageLength])
+        {
+        }
+
+        LogRingBuffer(const LogRingBuffer&) = delete;
+        LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+        // The entry's message offset and length are set from message.
+        void Append(const LogEntry& logEntry, std::string_view message)
+        {
+            const uint64_t ticket = m_NextTicket.fetch_add(1, std::memory_order_relaxed);
+            const size_t slotIndex = static_cast<size_t>(ticket % m_Capacity);
+            Slot& slot = m_Slots[slotIndex];
+
+            // Claim the slot by marking it as being written. Only with the buffer lapped during a single append can the slot be taken: a lapped writer
+            // finds a newer entry, which wins, and a lapping one finds the slot mid-write, in which case its entry is dropped rather than waiting.
+            uint64_t sequence = slot.m_Sequence.load(std::memory_order_relaxed);
+            do
+            {
+                if ((sequence & 1) || sequence > ticket * 2)
+                {
+                    return;
+                }
+            }
+            while (!slot.m_Sequence.compare_exchange_weak(sequence, ticket * 2 + 1, std::memory_order_relaxed));
+
+            std::atomic_thread_fence(std::memory_order_release);
+
+            const size_t messageLength = std::min(message.size(), m_MaxMessageLength);
+            std::memcpy(&m_Arena[slotIndex * m_MaxMessageLength], message.data(), messageLength);
+
+            slot.m_Entry = logEntry;
+            slot.m_Entry.m_MessageOffset = static_cast<uint32_t>(slotIndex * m_MaxMessageLength);
+            slot.m_Entry.m_MessageLength = static_cast<uint32_t>(messageLength);
+
+            slot.m_Sequence.store(ticket * 2 + 2, std::memory_order_release);
+        }
+
+        LogSnapshot Snapshot() const
+        {
+            LogSnapshot logSnapshot;
+
+            const uint64_t endTicket = m_NextTicket.load(std::memory_order_acquire);
+            const uint64_t beginTicket = endTicket > m_Capacity ? endTicket - m_Capacity : 0;
+
+            logSnapshot.m_Entries.reserve(static_cast<size_t>(endTicket - beginTicket));
+
+            for (uint64_t ticket = beginTicket; ticket < endTicket; ++ticket)
+            {
+                const size_t slotIndex = static_cast<size_t>(ticket % m_Capacity);
+                const Slot& slot = m_Slots[slotIndex];
+
+                if (slot.m_Sequence.load(std::memory_order_acquire) != ticket * 2 + 2)
+                {
+                    continue;
+                }
+
+                LogEntry logEntry = slot.m_Entry;
+                const size_t messageLength = std::min<size_t>(logEntry.m_MessageLength, m_MaxMessageLength);
+                const size_t textOffset = logSnapshot.m_Text.size();
+                logSnapshot.m_Text.insert(logSnapshot.m_Text.end(), &m_Arena[slotIndex * m_MaxMessageLength], &m_Arena[slotIndex * m_MaxMessageLength] + messageLength);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                // Overwritten while copying.
+                if (slot.m_Sequence.load(std::memory_order_relaxed) != ticket * 2 + 2)
+                {
+                    logSnapshot.m_Text.resize(textOffset);
+                    continue;
+                }
+
+                logEntry.m_MessageOffset = static_cast<uint32_t>(textOffset);
+                logEntry.m_MessageLength = static_cast<uint32_t>(messageLength);
+                logSnapshot.m_Entries.push_back(logEntry);
+            }
+
+            return logSnapshot;
+        }
+
+        size_t GetCapacity() const { return m_Capacity; }
+        size_t GetMaxMessageLength() const { return m_MaxMessageLength; }
+
+        // Everything ever appended, including entries since overwritten.
+        uint64_t GetAppendedCount() const { return m_NextTicket.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> m_Sequence = 0;   // Twice the ticket of the entry held, plus one while it is being written.
+            LogEntry m_Entry;
+        };
+
+        static constexpr size_t m_FalseSharingRange = 64;
+
+    private:
+        const size_t m_Capacity;
+        const size_t m_MaxMessageLength;
+        std::unique_ptr<Slot[]> m_Slots;
+        std::unique_ptr<char[]> m_Arena;
+
+        alignas(m_FalseSharingRange) std::atomic<uint64_t> m_NextTicket = 0;
+    };
+}
@@ -1,8 +1,8 @@
 #pragma once
 #include "LogClassification.h"
+#include "LogTimestamp.h"
 #include "../Debug/DebugCode.h"
 #include <string>
-#include <time.h>
 
 namespace Aurora
 {
@@ -10,22 +10,25 @@ namespace Aurora
     struct LogMetadata
     {
         LogMetadata() = default;
-        LogMetadata(const char* filePath, const std::string& functionName, int lineNumber) : m_FunctionName(functionName), m_FilePath(filePath), m_LineNumber(lineNumber)
-        {
-            // Capture time as a string.
-            time_t timeNow = time(nullptr);
-            struct std::tm timeStruct;
-            char buffer[80];
-            timeStruct = *localtime(&timeNow);
-            strftime(buffer, sizeof(buffer), "%X", &timeStruct);
+        LogMetadata(const char* filePath, const std::string& functionName, int lineNumber) : LogMetadata(filePath, functionName, lineNumber, LogClock::Now()) { }
 
-            m_LogTime = std::string(buffer);
-        }
+        // For messages logged at an earlier time, such as those formatted by the asynchronous backend.
+        LogMetadata(const char* filePath, const std::string& functionName, int lineNumber, LogTimestamp logTimestamp) : m_FunctionName(functionName), m_FilePath(filePath), m_LineNumber(lineNumber), m_LogTimestamp(logTimestamp) { }
 
         int m_LineNumber = 0;
         const char* m_FilePath = "";
         std::string m_FunctionName = "";
-        std::string m_LogTime = "";
+        LogTimestamp m_LogTimestamp = 0;    // Formatted when output, see LogTimestampCache.
+    };
+
+    // The parts of a log call known at compile time. Each call site has a single static instance.
+    struct LogSite
+    {
+        constexpr LogSite(const char* filePath, const char* functionName, int lineNumber) : m_FilePath(filePath), m_FunctionName(functionName), m_LineNumber(lineNumber) { }
+
+        const char* m_FilePath;
+        const char* m_FunctionName;
+        int m_LineNumber;
     };
 
     struct LogPayload
@@ -33,7 +36,7 @@ namespace Aurora
         LogLayer m_LogLayer = LogLayer::Unknown;
         LogLevel m_LogLevel = LogLevel::Unknown;
         DebugCode m_DebugCode = DebugCode::AURORA_MAX_ENUM;
-        const char* m_LogMessage = "";
+        std::string m_LogMessage = "";  // Owned, as formatted messages don't outlive the call that logs them.
 
         LogMetadata m_LogMetadata;
     };
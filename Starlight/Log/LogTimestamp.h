@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+namespace Aurora
+{
+    // Raw steady clock ticks, as taken on the logging thread. Only turned into wall clock time when formatted.
+    using LogTimestamp = int64_t;
+
+    class LogClock
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static LogTimestamp Now()
+        {
+            return Clock::now().time_since_epoch().count();
+        }
+
+        // Maps ticks onto the wall clock through a pair of readings of both clocks, taken on first use.
+        static std::chrono::system_clock::time_point ToSystemTime(LogTimestamp logTimestamp)
+        {
+            const Calibration& calibration = GetCalibration();
+            return calibration.m_SystemTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(Clock::time_point(Clock::duration(logTimestamp)) - calibration.m_SteadyTime);
+        }
+
+        static time_t ToTimeT(LogTimestamp logTimestamp)
+        {
+            return std::chrono::system_clock::to_time_t(ToSystemTime(logTimestamp));
+        }
+
+    private:
+        struct Calibration
+        {
+            Clock::time_point m_SteadyTime = Clock::now();
+            std::chrono::system_clock::time_point m_SystemTime = std::chrono::system_clock::now();
+        };
+
+        static const Calibration& GetCalibration()
+        {
+            static const Calibration calibration;
+            return calibration;
+        }
+    };
+
+    /*
+        Formats timestamps as local "%X" time. Consecutive messages mostly fall within the same second, so the text for the last second formatted is
+        kept, and localtime and strftime only run when the second changes. Not thread safe, so each formatting thread keeps its own.
+    */
+    class LogTimestampCache
+    {
+    public:
+        std::string_view Format(LogTimestamp logTimestamp)
+        {
+            const time_t logTime = LogClock::ToTimeT(logTimestamp);
+
+            if (logTime != m_CachedTime || m_CachedLength == 0)
+            {
+                struct std::tm timeStruct = *localtime(&logTime);
+                m_CachedLength = strftime(m_CachedText, sizeof(m_CachedText), "%X", &timeStruct);
+                m_CachedTime = logTime;
+            }
+
+            return std::string_view(m_CachedText, m_CachedLength);
+        }
+
+    private:
+        time_t m_CachedTime = 0;
+        size_t m_CachedLength = 0;
+        char m_CachedText[80] = {};
+    };
+}
@@ -4,6 +4,20 @@
 
 namespace Aurora
 {
+    namespace
+    {
+        LogTimestampCache& GetTimestampCache()
+        {
+            thread_local LogTimestampCache timestampCache;
+            return timestampCache;
+        }
+    }
+
+    Logger::~Logger()
+    {
+        DisableAsyncMode();
+    }
+
     void Logger::EnableTimestamps()
     {
         if (!m_TimestampsEnabled)
@@ -20,8 +34,84 @@ namespace Aurora
         }
     }
 
+    void Logger::EnableAsyncMode(size_t queueCapacity)
+    {
+        if (!m_AsyncLogBackendOwner)
+        {
+            m_AsyncLogBackendOwner = std::make_unique<AsyncLogBackend>(queueCapacity, [this](const LogRecord& logRecord) { LogRecordFinal(logRecord); });
+            m_AsyncLogBackend.store(m_AsyncLogBackendOwner.get(), std::memory_order_release);
+        }
+    }
+
+    void Logger::DisableAsyncMode()
+    {
+        if (m_AsyncLogBackendOwner)
+        {
+            m_AsyncLogBackend.store(nullptr, std::memory_order_release);
+            m_AsyncLogBackendOwner.reset();
+        }
+    }
+
+    bool Logger::EnableBinaryLogging(const std::string& filePath)
+    {
+        return m_BinaryLogSink.Open(filePath);
+    }
+
+    void Logger::DisableBinaryLogging()
+    {
+        // Anything still queued belongs in the file.
+        if (AsyncLogBackend* asyncLogBackend = m_AsyncLogBackend.load(std::memory_order_acquire))
+        {
+            asyncLogBackend->Flush();
+        }
+
+        m_BinaryLogSink.Close();
+    }
+
+    void Logger::Flush()
+    {
+        if (AsyncLogBackend* asyncLogBackend = m_AsyncLogBackend.load(std::memory_order_acquire))
+        {
+            asyncLogBackend->Flush();
+        }
+
+        m_BinaryLogSink.Flush();
+
+        std::cout.flush();
+    }
+
+    LogSnapshot Logger::GetBackbufferSnapshot() const
+    {
+        return m_Backbuffer.Snapshot();
+    }
+
+    void Logger::DumpBackbuffer() const
+    {
+        const LogSnapshot logSnapshot = m_Backbuffer.Snapshot();
+
+        std::cout << fmt::format("Backbuffer ({} of {} messages):\n", logSnapshot.m_Entries.size(), m_Backbuffer.GetAppendedCount());
+
+        for (const LogEntry& logEntry : logSnapshot.m_Entries)
+        {
+            LogPayload logPayload;
+
+            logPayload.m_LogLevel = logEntry.m_LogLevel;
+            logPayload.m_LogLayer = logEntry.m_LogLayer;
+            logPayload.m_DebugCode = logEntry.m_DebugCode;
+            logPayload.m_LogMessage = logSnapshot.GetMessage(logEntry);
+            logPayload.m_LogMetadata = LogMetadata(logEntry.m_FilePath, "", logEntry.m_LineNumber, logEntry.m_LogTime);
+
+            std::cout << (m_TimestampsEnabled ? LogFormatter_WithTimestamps(logPayload, GetTimestampCache().Format(logEntry.m_LogTime)) : LogFormatter_Complete(logPayload));
+        }
+    }
+
     void Logger::LogMessageError(LogLayer logLayer, DebugCode debugCode, const char* logMessage, const LogMetadata& metaData)
     {
+        if (!s_LogFilter.IsEnabled(logLayer, LogLevel::Error))
+        {
+            return;
+        }
+
         LogPayload logPayload;
 
         logPayload.m_LogLevel = LogLevel::Error;
@@ -33,18 +123,51 @@ namespace Aurora
         LogMessageFinal(logPayload);
     }
 
+    void Logger::LogRecordFinal(const LogRecord& logRecord)
+    {
+        if (m_BinaryLogSink.IsOpen())
+        {
+            m_BinaryLogSink.Write(logRecord);
+            return;
+        }
+
+        fmt::memory_buffer messageBuffer;
+        logRecord.FormatMessage(messageBuffer);
+
+        const LogSite& logSite = logRecord.GetLogSite();
+
+        LogPayload logPayload;
+
+        logPayload.m_LogLevel = logRecord.GetLogLevel();
+        logPayload.m_LogLayer = logRecord.GetLogLayer();
+        logPayload.m_DebugCode = logRecord.GetDebugCode();
+        logPayload.m_LogMessage.assign(messageBuffer.data(), messageBuffer.size());
+        logPayload.m_LogMetadata = LogMetadata(logSite.m_FilePath, logSite.m_FunctionName, logSite.m_LineNumber, logRecord.GetLogTime());
+
+        LogMessageFinal(logPayload);
+    }
+
     // Everything that arrives here are to have completed formatting/processing etc.
     void Logger::LogMessageFinal(const LogPayload& logPackage)
     {
         // Save to backtrace buffer at this stage and log appropriate message based on formatting type.
         if (m_BackbufferEnabled)
         {
-            m_LogPayloadBuffer.push_back(logPackage);
+            LogEntry logEntry;
+
+            logEntry.m_LogLayer = logPackage.m_LogLayer;
+            logEntry.m_LogLevel = logPackage.m_LogLevel;
+            logEntry.m_DebugCode = logPackage.m_DebugCode;
+            logEntry.m_LineNumber = logPackage.m_LogMetadata.m_LineNumber;
+            logEntry.m_FilePath = logPackage.m_LogMetadata.m_FilePath;
+            logEntry.m_LogTime = logPackage.m_LogMetadata.m_LogTimestamp;
+
+            m_Backbuffer.Append(logEntry, logPackage.m_LogMessage);
         }
 
         if (m_TimestampsEnabled)
         {
-            std::cout << LogFormatter_WithTimestamps(logPackage);
+            std::cout << LogFormatter_WithTimestamps(logPackage, GetTimestampCache().Format(logPackage.m_LogMetadata.m_LogTimestamp));
             return;
         }
         else
@@ -1,7 +1,14 @@
 #pragma once
 #include "LogClassification.h"
 #include "LogStructures.h"
+#include "LogFilter.h"
+#include "LogRecord.h"
+#include "LogRingBuffer.h"
+#include "AsyncLogBackend.h"
+#include "BinaryLogSink.h"
 #include "../Debug/DebugCode.h"
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,9 +23,51 @@ namespace Aurora
             return loggerInstance;
         }
 
+        ~Logger();
+
         void EnableTimestamps();
         void EnableBackbuffer();
 
+        // The backbuffer keeps the most recent messages, up to BackbufferCapacity of them, each truncated to MaxBackbufferMessageLength.
+        LogSnapshot GetBackbufferSnapshot() const;
+        void DumpBackbuffer() const;
+
+        /*
+            In asynchronous mode, logging only captures a LogRecord into a queue owned by the calling thread. A background thread formats and
+            outputs them. Switch modes while no other thread is logging, such as at startup and shutdown. Disabling outputs everything still
+            queued first.
+        */
+        void EnableAsyncMode(size_t queueCapacity = 1024);
+        void DisableAsyncMode();
+        bool IsAsyncModeEnabled() const { return m_AsyncLogBackend.load(std::memory_order_acquire) != nullptr; }
+
+        /*
+            While binary logging is enabled, records are written to filePath by a BinaryLogSink instead of being formatted, and so skip the console
+            and the backbuffer. Switch it as with asynchronous mode. Returns false if the file couldn't be opened.
+        */
+        bool EnableBinaryLogging(const std::string& filePath);
+        void DisableBinaryLogging();
+        bool IsBinaryLoggingEnabled() const { return m_BinaryLogSink.IsOpen(); }
+
+        // Blocks until everything logged before the call has been output.
+        void Flush();
+
+        // Checked by the AURORA_* macros, ahead of everything else. Calling LogMessage directly skips it.
+        static LogFilter& GetFilter() { return s_LogFilter; }
+
+        // The message is a compiled format string, or a C string that is an fmt format string when there are arguments. See LogRecord.
+        template <typename LogMessageType, typename... Args>
+        void LogMessage(const LogSite& logSite, LogLayer logLayer, LogLevel logLevel, DebugCode debugCode, const LogMessageType& logMessage, Args&&... args)
+        {
+            if (AsyncLogBackend* asyncLogBackend = m_AsyncLogBackend.load(std::memory_order_acquire))
+            {
+                asyncLogBackend->Push(logSite, logLayer, logLevel, debugCode, LogClock::Now(), logMessage, std::forward<Args>(args)...);
+                return;
+            }
+
+            LogRecordFinal(LogRecord(logSite, logLayer, logLevel, debugCode, LogClock::Now(), logMessage, std::forward<Args>(args)...));
+        }
+
 
         // Core
         // void LogMessageWarning(LogLayer logLayer, DebugCode debugCode, const char* logMessage, const LogMetadata& metaData);
@@ -27,11 +76,25 @@ namespace Aurora
         // Everything resolves to this.
         void LogMessageFinal(const LogPayload& logPackage);
 
+    private:
+        // Formats the record's message and passes it on to LogMessageFinal, or writes it to the binary log.
+        void LogRecordFinal(const LogRecord& logRecord);
+
     private:
         bool m_TimestampsEnabled = true;
         bool m_BackbufferEnabled = true;
 
-        // Buffer to store messages for future retrieval. To implement custom ringbuffer in the future. 
-        std::vector<LogPayload> m_LogPayloadBuffer;
+        static constexpr size_t BackbufferCapacity = 1024;
+        static constexpr size_t MaxBackbufferMessageLength = 256;
+
+        // Messages stored for future retrieval.
+        LogRingBuffer m_Backbuffer = LogRingBuffer(BackbufferCapacity, MaxBackbufferMessageLength);
+
+        static inline LogFilter s_LogFilter;  // Constant initialized, so checking it involves no guard for a function local static.
+
+        std::atomic<AsyncLogBackend*> m_AsyncLogBackend = nullptr;
+        std::unique_ptr<AsyncLogBackend> m_AsyncLogBackendOwner;
+
+        BinaryLogSink m_BinaryLogSink;
     };
 }
\ No newline at end of file
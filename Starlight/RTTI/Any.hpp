@@ -6,16 +6,160 @@
 #include <utility>
 #include <string>
 #include <exception>
+#include <new>
 #include "TypeDescriptor.hpp"
 
 /*
 	The Any class is the representation of our object.
+
+	Objects up to SIZE bytes are stored inline. Larger ones live in blocks recycled through a per thread pool. The default size holds strings,
+	small vectors and most plain structs, so that reflected reads of them don't allocate. Use BasicAny<N> directly where a different size suits better.
 */
 
+#ifndef RTTI_ANY_INLINE_SIZE
+#define RTTI_ANY_INLINE_SIZE 32
+#endif
+
 namespace RTTI
 {
 	namespace Details
 	{
+		// Recycles the blocks of objects too large for an Any's inline storage. Free lists are per thread so there is no locking. Blocks are ordinary
+		// allocations, so one allocated on a thread may be released on any other.
+		class AnyPool
+		{
+		public:
+			static constexpr std::size_t MinimumBlockSize = 64;
+			static constexpr std::size_t SizeClassCount = 4;          // 64, 128, 256 and 512 bytes. Anything larger uses new directly.
+			static constexpr std::size_t MaximumCachedBlocks = 256;   // Per size class and thread, to bound what an idle thread holds on to.
+
+			static constexpr bool IsPooled(std::size_t size, std::size_t alignment)
+			{
+				return size <= (MinimumBlockSize << (SizeClassCount - 1)) && alignment <= alignof(std::max_align_t);
+			}
+
+			static void *Allocate(std::size_t size)
+			{
+				FreeLists &freeLists = GetFreeLists();
+				const std::size_t sizeClass = GetSizeClass(size);
+
+				if (Block *block = freeLists.m_Heads[sizeClass])
+				{
+					freeLists.m_Heads[sizeClass] = block->m_Next;
+					--freeLists.m_Counts[sizeClass];
+
+					return block;
+				}
+
+				return ::operator new(MinimumBlockSize << sizeClass);
+			}
+
+			static void Deallocate(void *memory, std::size_t size)
+			{
+				FreeLists &freeLists = GetFreeLists();
+				const std::size_t sizeClass = GetSizeClass(size);
+
+				if (freeLists.m_IsReleased || freeLists.m_Counts[sizeClass] >= MaximumCachedBlocks)
+				{
+					::operator delete(memory);
+					return;
+				}
+
+				freeLists.m_Heads[sizeClass] = new(memory) Block{ freeLists.m_Heads[sizeClass] };
+				++freeLists.m_Counts[sizeClass];
+			}
+
+		private:
+			struct Block
+			{
+				Block *m_Next;
+			};
+
+			// Trivially destructible, so blocks released during static destruction (after the thread's cache is gone) can still check m_IsReleased.
+			struct FreeLists
+			{
+				Block *m_Heads[SizeClassCount];
+				std::size_t m_Counts[SizeClassCount];
+				bool m_IsReleased;
+			};
+
+			// Frees a thread's cached blocks when it exits.
+			struct FreeListsReleaser
+			{
+				FreeLists &m_FreeLists;
+
+				~FreeListsReleaser()
+				{
+					for (std::size_t sizeClass = 0; sizeClass < SizeClassCount; ++sizeClass)
+					{
+						while (Block *block = m_FreeLists.m_Heads[sizeClass])
+						{
+							m_FreeLists.m_Heads[sizeClass] = block->m_Next;
+							::operator delete(block);
+						}
+
+						m_FreeLists.m_Counts[sizeClass] = 0;
+					}
+
+					m_FreeLists.m_IsReleased = true;
+				}
+			};
+
+			static FreeLists &GetFreeLists()
+			{
+				thread_local FreeLists freeLists = {};
+				thread_local FreeListsReleaser freeListsReleaser{ freeLists };
+
+				return freeLists;
+			}
+
+			static std::size_t GetSizeClass(std::size_t size)
+			{
+				std::size_t sizeClass = 0;
+				while ((MinimumBlockSize << sizeClass) < size)
+					++sizeClass;
+
+				return sizeClass;
+			}
+		};
+
+		template <typename T, typename... Args>
+		T *NewPooled(Args&&... args)
+		{
+			if constexpr (AnyPool::IsPooled(sizeof(T), alignof(T)))
+			{
+				void *memory = AnyPool::Allocate(sizeof(T));
+
+				try
+				{
+					return new(memory) T(std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					AnyPool::Deallocate(memory, sizeof(T));
+					throw;
+				}
+			}
+			else
+			{
+				return new T(std::forward<Args>(args)...);
+			}
+		}
+
+		template <typename T>
+		void DeletePooled(T *instance)
+		{
+			if constexpr (AnyPool::IsPooled(sizeof(T), alignof(T)))
+			{
+				instance->~T();
+				AnyPool::Deallocate(instance, sizeof(T));
+			}
+			else
+			{
+				delete instance;
+			}
+		}
+
 		template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t)>
 		struct AlignedStorage
 		{
@@ -50,24 +194,92 @@ namespace RTTI
 	template <std::size_t>
 	class BasicAny;
 
-	using Any = BasicAny<sizeof(void*)>;
+	using Any = BasicAny<RTTI_ANY_INLINE_SIZE>;
+
+	namespace Details
+	{
+		template <typename>
+		struct IsBasicAny : std::false_type {};
+
+		template <std::size_t SIZE>
+		struct IsBasicAny<BasicAny<SIZE>> : std::true_type {};
 
+		// Casts an instance of the given type to the target (or T), either directly or through one of its bases. Returns nullptr if neither matches. Defined in Base.hpp.
+		inline void *CastInstance(void *instance, const TypeDescriptor *type, const TypeDescriptor *target);
+
+		template <typename T>
+		void *CastInstance(void *instance, const TypeDescriptor *type);
+
+		// Converts an instance of the given type to the target through a registered conversion. Returns an empty Any if there is none. Defined in Conversion.hpp.
+		inline Any ConvertInstance(const void *instance, const TypeDescriptor *type, const TypeDescriptor *target);
+
+		// Arrays, i.e. string literals, are passed on as pointers, as Any would store them. Everything else is forwarded as is.
+		template <typename T>
+		decltype(auto) DecayArray(T &&value)
+		{
+			if constexpr (std::is_array_v<std::remove_reference_t<T>>)
+				return static_cast<std::decay_t<T>>(value);
+			else
+				return std::forward<T>(value);
+		}
+	}  // namespace Details
+
+	/*
+		A non-owning view of an object. Cheap enough to pass reflected arguments on the stack.
+
+		The view remembers whether the object is const, and whether it was passed as an rvalue (ForwardRef) and so may be moved from. Get still
+		returns a mutable pointer. Check IsConst before writing through it.
+	*/
 	class AnyRef
 	{
 		template <std::size_t> friend class BasicAny;
 
 	public:
-		AnyRef() : mInstance(nullptr), mType(nullptr) {}
+		AnyRef() : mInstance(nullptr), mType(nullptr), mIsConst(false), mIsMovable(false) {}
+
+		template <typename T, typename U = std::remove_cv_t<T>, typename = std::enable_if_t<!std::is_same_v<U, AnyRef> && !Details::IsBasicAny<U>::value>>
+		AnyRef(T &object, bool isMovable = false)
+			: mInstance(const_cast<void*>(static_cast<const void*>(&object))), mType(Details::Resolve<U>()), mIsConst(std::is_const_v<T>), mIsMovable(isMovable && !std::is_const_v<T>) {}
 
-		template <typename T, typename U = std::remove_cv_t<T>, typename = std::enable_if_t<!std::is_same_v<U, AnyRef>>>
-		AnyRef(T &object) : mInstance(&object), mType(Details::Resolve<U>()) {}
+		template <std::size_t SIZE>
+		AnyRef(BasicAny<SIZE> &any, bool isMovable = false) : mInstance(any.mInstance), mType(any.mType), mIsConst(false), mIsMovable(isMovable && !any.IsRef()) {}
 
 		template <std::size_t SIZE>
-		AnyRef(BasicAny<SIZE> &any) : mInstance(any.mInstance), mType(any.mType) {}
+		AnyRef(const BasicAny<SIZE> &any) : mInstance(any.mInstance), mType(any.mType), mIsConst(true), mIsMovable(false) {}
+
+		// Views an argument of a forwarding reference parameter, i.e. ForwardRef<Args>(args), so that rvalues may be moved from. Views are passed on as they are.
+		template <typename T>
+		static AnyRef ForwardRef(std::remove_reference_t<T> &object)
+		{
+			if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, AnyRef>)
+				return object;
+			else if constexpr (std::is_const_v<std::remove_reference_t<T>>)
+				return AnyRef(object);
+			else
+				return AnyRef(object, !std::is_lvalue_reference_v<T>);
+		}
+
+		explicit operator bool() const { return mInstance != nullptr; }
+
+		const TypeDescriptor *GetType() const { return mType; }
+
+		bool IsConst() const { return mIsConst; }
+
+		bool IsMovable() const { return mIsMovable; }
+
+		void *Get() const { return mInstance; }
+
+		template <typename T>
+		T *TryCast() const
+		{
+			return static_cast<T*>(Details::CastInstance<T>(mInstance, mType));
+		}
 
 	private:
 		void *mInstance;
 		TypeDescriptor const *mType;
+		bool mIsConst;
+		bool mIsMovable;
 	};
 
 	template <std::size_t SIZE>
@@ -140,7 +352,7 @@ namespace RTTI
 			template <typename... Args>
 			static void *New(void *storage, Args&&... args)
 			{
-				T *instance = new T(std::forward<Args>(args)...);
+				T *instance = Details::NewPooled<T>(std::forward<Args>(args)...);
 				new(storage) T*(instance);
 
 				return instance;
@@ -148,7 +360,7 @@ namespace RTTI
 
 			static void *Copy(void *to, const void *from)
 			{
-				T *instance = new T(*static_cast<const T*>(from));
+				T *instance = Details::NewPooled<T>(*static_cast<const T*>(from));
 				new(to) T*(instance);
 
 				return instance;
@@ -164,12 +376,12 @@ namespace RTTI
 
 			static void Destroy(void *instance)
 			{
-				delete static_cast<T*>(instance);
+				Details::DeletePooled(static_cast<T*>(instance));
 			}
 		};
 
 		template <typename T>
-		struct TypeTraits<T, typename std::enable_if<sizeof(T) <= SIZE>::type>
+		struct TypeTraits<T, typename std::enable_if<sizeof(T) <= SIZE && alignof(T) <= alignof(std::max_align_t)>::type>
 		{
 			template <typename... Args>
 			static void *New(void *storage, Args&&... args)
@@ -340,23 +552,7 @@ namespace RTTI
 	template <typename T>
 	const T *BasicAny<SIZE>::TryCast() const
 	{
-		const TypeDescriptor *typeDesc = typeDesc = Details::Resolve<T>();
-		
-		void *casted = nullptr;
-
-		if (!*this)
-			return static_cast<T const*>(casted);
-
-		if (typeDesc == mType)
-			casted = mInstance;
-		else
-		{
-			for (auto *base : mType->GetBases())
-				if (base->GetType() == typeDesc)
-					casted = base->Cast(mInstance);
-		}
-
-		return static_cast<T const*>(casted);
+		return static_cast<T const*>(Details::CastInstance<T>(mInstance, mType));
 	}
 
 	template <std::size_t SIZE>
@@ -379,15 +575,25 @@ namespace RTTI
 		if (TypeDescriptor const *typeDesc = Details::Resolve<T>(); typeDesc == mType)
 			converted = *this;
 		else
-		{
-			for (auto *conversion : mType->GetConversions())
-				if (conversion->GetToType() == typeDesc)
-					converted = conversion->Convert(mInstance);
-		}
+			converted = Details::ConvertInstance(mInstance, mType, typeDesc);
 
 		return converted;
 	}
 
+	namespace Details
+	{
+		// Values of type T (or a type deriving from it) are used in place. Anything else goes through a registered conversion into storage. Returns nullptr if neither applies.
+		template <typename T>
+		T *CastOrConvert(AnyRef value, Any &storage)
+		{
+			if (T *casted = value.TryCast<T>())
+				return casted;
+
+			storage = ConvertInstance(value.Get(), value.GetType(), Resolve<T>());  // Converts straight from the referenced value, without copying it first.
+			return storage.TryCast<T>();
+		}
+	}  // namespace Details
+
 }  // namespace Reflect
 
 #endif  // META_ANY_H
\ No newline at end of file
@@ -19,18 +19,38 @@ namespace RTTI
 		const TypeDescriptor* m_BaseType;
 	};
 
-	template <typename Type, typename Base>
+	template <typename Type, typename BaseType>
 	class BaseImplementation : public Base
 	{
 	public:
-		BaseImplementation() : Base(Details::Resolve<Base>(), Details::Resolve<Type>()) {}
+		BaseImplementation() : Base(Details::Resolve<BaseType>(), Details::Resolve<Type>()) {}
 
 		// Cast any incoming object into our base type.
 		void* Cast(void* object) override
 		{
-			return static_cast<Base*>(object);
+			return static_cast<BaseType*>(static_cast<Type*>(object));
 		}
 	};
+
+	namespace Details
+	{
+		inline void* CastInstance(void* instance, const TypeDescriptor* type, const TypeDescriptor* target)
+		{
+			if (!instance || type == target)
+			{
+				return instance;
+			}
+
+			Base* base = type->GetConversionPath(target).m_Base;
+
+			return base ? base->Cast(instance) : nullptr;
+		}
+		template <typename T>
+		void* CastInstance(void* instance, const TypeDescriptor* type)
+		{
+			return CastInstance(instance, type, Resolve<T>());
+		}
+	}
 }
 
 #endif
@@ -1,49 +1,142 @@
 #ifndef CONSTRUCTOR_H
 #define CONSTRUCTOR_H
 
+#include <new>
 #include <vector>
 #include <tuple>
+#include <utility>
 #include "TypeDescriptor.hpp"
 #include "Any.hpp"
 #include "Conversion.hpp"
 #include "Base.hpp"
+#include "Function.hpp"
+#include "ObjectPool.hpp"
 
 namespace RTTI
 {
+	// True if the types are the same, or from reaches to through a base or a conversion. Past the first query for a pair, this is a single cache probe.
 	inline bool CanCastOrConvert(const TypeDescriptor* from, const TypeDescriptor* to)
 	{
-		if (from == to) // If our types are the same...
+		return from == to || static_cast<bool>(from->GetConversionPath(to));
+	}
+
+	namespace Details
+	{
+		template <typename Type>
+		void DestroyInstance(void* instance)
 		{
-			return true;
+			static_cast<Type*>(instance)->~Type();
 		}
 
-		for (auto* base : from->GetBases()) // Check if the base type is the same...
+		// Passes a copy to rvalue reference parameters, leaving the argument for the next instance. Every other parameter binds to or copies from the argument.
+		template <typename T>
+		decltype(auto) CopyArgument(ParameterType<T>* argument)
 		{
-			if (base->GetType() == to)
+			if constexpr (std::is_rvalue_reference_v<T>)
 			{
-				return true;
+				return ParameterType<T>(*argument);
+			}
+			else
+			{
+				return (*argument);
 			}
 		}
 
-		for (auto* conversion : from->GetConversions()) // Else, check if a conversione exists between the two types...
+		// Casts every argument once, then calls construct with them for each storage in turn. Returns false, constructing nothing, if any argument is incompatible.
+		// If a construction throws, the instances already constructed are destroyed with destroy before the exception propagates.
+		template <typename... Args>
+		struct Construction
 		{
-			if (conversion->GetToType() == to)
+			static_assert(sizeof...(Args) <= Function::MaxParameterCount, "Too many parameters for a reflected constructor.");
+
+			template <typename Construct>
+			static bool ConstructAt(void* const* storage, size_t count, AnyRef* args, Construct&& construct, ObjectPool::DestroyFunction destroy)
+			{
+				return ConstructAt(storage, count, args, construct, destroy, std::index_sequence_for<Args...>());
+			}
+
+			template <typename Construct, size_t... indices>
+			static bool ConstructAt(void* const* storage, size_t count, [[maybe_unused]] AnyRef* args, Construct& construct, ObjectPool::DestroyFunction destroy, std::index_sequence<indices...>)
 			{
+				[[maybe_unused]] Any convertedArgs[sizeof...(Args) + 1];
+				std::tuple<ParameterType<Args>*...> castedArgs{ GetArgument<Args>(args[indices], convertedArgs[indices])... };
+
+				if (!(std::get<indices>(castedArgs) && ...))
+				{
+					return false;
+				}
+
+				size_t constructedCount = 0;
+				try
+				{
+					// Every instance but the last gets copies, so that rvalue reference parameters are only moved from once.
+					for (; constructedCount + 1 < count; ++constructedCount)
+					{
+						construct(storage[constructedCount], CopyArgument<Args>(std::get<indices>(castedArgs))...);
+					}
+
+					if (count > 0)
+					{
+						construct(storage[count - 1], PassArgument<Args>(std::get<indices>(castedArgs))...);
+					}
+				}
+				catch (...)
+				{
+					while (constructedCount > 0)
+					{
+						destroy(storage[--constructedCount]);
+					}
+
+					throw;
+				}
+
 				return true;
 			}
-		}
 
-		return false; // Gives up...
+			template <typename Factory>
+			static Any Create(AnyRef* args, Factory&& create)
+			{
+				return Create(args, create, std::index_sequence_for<Args...>());
+			}
+
+			template <typename Factory, size_t... indices>
+			static Any Create([[maybe_unused]] AnyRef* args, Factory& create, std::index_sequence<indices...>)
+			{
+				[[maybe_unused]] Any convertedArgs[sizeof...(Args) + 1];
+				std::tuple<ParameterType<Args>*...> castedArgs{ GetArgument<Args>(args[indices], convertedArgs[indices])... };
+
+				if (!(std::get<indices>(castedArgs) && ...))
+				{
+					return Any();
+				}
+
+				return create(PassArgument<Args>(std::get<indices>(castedArgs))...);
+			}
+		};
 	}
 
+	/*
+		Constructs reflected types, either into an Any (NewInstance) or into storage the caller provides (NewInstanceAt, NewInstances). Arguments are
+		passed by reference through a stack array and only copied when they need a conversion, or when an rvalue reference parameter receives an
+		lvalue. Only arguments passed as rvalues are moved from.
+
+		For in place construction, storage must be at least GetInstanceSize() bytes, aligned to GetInstanceAlignment(), and instances are destroyed
+		with DestroyInstance. Factory functions that return pointers or references can't construct in place, so report an instance size of zero.
+	*/
 	class Constructor
 	{
 	public:
-		Any NewInstance(std::vector<Any>& args)
+		Any NewInstance(std::vector<Any>& args) const
 		{
 			if (args.size() == m_ParameterTypes.size())
 			{
-				return NewInstanceImplementation(args);
+				AnyRef argRefs[Function::MaxParameterCount];
+				for (size_t i = 0; i < args.size(); ++i)
+				{
+					argRefs[i] = args[i];
+				}
+
+				return NewInstanceImplementation(argRefs);
 			}
 
 			return Any();
@@ -54,13 +147,108 @@ namespace RTTI
 		{
 			if (sizeof...(Args) == m_ParameterTypes.size())
 			{
-				auto argsAny = std::vector<Any>({ Any(std::forward<Args>(args))... });
-				return NewInstanceImplementation(argsAny);
+				return NewInstanceWithReferences(Details::DecayArray(std::forward<Args>(args))...);
 			}
 
 			return Any();
 		}
 
+		// Returns the instance, or nullptr if the arguments don't fit, in which case storage is left untouched.
+		template <typename... Args>
+		void* NewInstanceAt(void* storage, Args&&... args) const
+		{
+			return NewInstancesAt(&storage, 1, std::forward<Args>(args)...) ? storage : nullptr;
+		}
+
+		// Constructs an instance in each of count storages. Arguments are cast, or converted, once for the whole batch. Returns false, constructing nothing, if they don't fit.
+		template <typename... Args>
+		bool NewInstancesAt(void* const* storage, size_t count, Args&&... args) const
+		{
+			if (sizeof...(Args) == m_ParameterTypes.size() && CanConstructInPlace())
+			{
+				return NewInstancesAtWithReferences(storage, count, Details::DecayArray(std::forward<Args>(args))...);
+			}
+
+			return false;
+		}
+
+		/*
+			Constructs count instances in storage from allocator, which provides void* Allocate(size_t size, size_t alignment) and void Deallocate(void*,
+			size_t size, size_t alignment). Writes the instances to instances and returns count, or returns 0, holding on to no storage, if the
+			arguments don't fit. If an allocation or a construction throws, everything allocated so far is released before the exception propagates.
+		*/
+		template <typename Allocator, typename... Args>
+		size_t NewInstances(size_t count, Allocator& allocator, void** instances, Args&&... args) const
+		{
+			if (sizeof...(Args) != m_ParameterTypes.size() || !CanConstructInPlace())
+			{
+				return 0;
+			}
+
+			size_t allocatedCount = 0;
+			bool isConstructed = false;
+			try
+			{
+				for (; allocatedCount < count; ++allocatedCount)
+				{
+					instances[allocatedCount] = allocator.Allocate(m_InstanceSize, m_InstanceAlignment);
+				}
+
+				isConstructed = NewInstancesAt(instances, count, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				DeallocateInstances(allocator, instances, allocatedCount);
+				throw;
+			}
+
+			if (isConstructed)
+			{
+				return count;
+			}
+
+			DeallocateInstances(allocator, instances, allocatedCount);
+
+			return 0;
+		}
+
+		// Takes the whole batch from the pool under one lock. Release the instances with ObjectPool::Delete.
+		template <typename... Args>
+		size_t NewInstances(size_t count, ObjectPool& objectPool, void** instances, Args&&... args) const
+		{
+			if (sizeof...(Args) != m_ParameterTypes.size() || !CanConstructInPlace() || objectPool.GetInstanceSize() < m_InstanceSize)
+			{
+				return 0;
+			}
+
+			objectPool.Allocate(instances, count);
+
+			bool isConstructed = false;
+			try
+			{
+				isConstructed = NewInstancesAt(instances, count, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				objectPool.Deallocate(instances, count);
+				throw;
+			}
+
+			if (isConstructed)
+			{
+				return count;
+			}
+
+			objectPool.Deallocate(instances, count);
+
+			return 0;
+		}
+
+		void DestroyInstance(void* instance) const
+		{
+			m_Destroy(instance);
+		}
+
 		const TypeDescriptor* GetParent() const
 		{
 			return m_Parent;
@@ -76,6 +264,11 @@ namespace RTTI
 			return m_ParameterTypes.size();
 		}
 
+		size_t GetInstanceSize() const { return m_InstanceSize; }
+		size_t GetInstanceAlignment() const { return m_InstanceAlignment; }
+		ObjectPool::DestroyFunction GetDestroyFunction() const { return m_Destroy; }
+		bool CanConstructInPlace() const { return m_InstanceSize > 0; }
+
 		template <typename... Args, size_t ...indices>
 		bool CanConstruct(std::index_sequence<indices...> indexSequence = std::index_sequence_for<Args...>()) const
 		{
@@ -83,41 +276,61 @@ namespace RTTI
 		}
 
 	protected:
-		Constructor(TypeDescriptor* parent, const std::vector<const TypeDescriptor*>& parameterTypes) : m_Parent(parent), m_ParameterTypes(parameterTypes) {}
+		Constructor(TypeDescriptor* parent, const std::vector<const TypeDescriptor*>& parameterTypes, size_t instanceSize, size_t instanceAlignment, ObjectPool::DestroyFunction destroy)
+			: m_Parent(parent), m_ParameterTypes(parameterTypes), m_InstanceSize(instanceSize), m_InstanceAlignment(instanceAlignment), m_Destroy(destroy) {}
 
 	private:
-		virtual Any NewInstanceImplementation(std::vector<Any>& args) const = 0;
+		template <typename Allocator>
+		void DeallocateInstances(Allocator& allocator, void* const* instances, size_t count) const
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				allocator.Deallocate(instances[i], m_InstanceSize, m_InstanceAlignment);
+			}
+		}
+
+		template <typename... Args>
+		Any NewInstanceWithReferences(Args&&... args) const
+		{
+			AnyRef argRefs[sizeof...(Args) + 1] = { AnyRef::ForwardRef<Args>(args)... };
+			return NewInstanceImplementation(argRefs);
+		}
+
+		template <typename... Args>
+		bool NewInstancesAtWithReferences(void* const* storage, size_t count, Args&&... args) const
+		{
+			AnyRef argRefs[sizeof...(Args) + 1] = { AnyRef::ForwardRef<Args>(args)... };
+			return NewInstancesAtImplementation(storage, count, argRefs);
+		}
+
+		// Both receive exactly GetParameterCount() arguments.
+		virtual Any NewInstanceImplementation(AnyRef* args) const = 0;
+		virtual bool NewInstancesAtImplementation(void* const* storage, size_t count, AnyRef* args) const = 0;
 
 	private:
 		TypeDescriptor* m_Parent;
 		std::vector<const TypeDescriptor*> m_ParameterTypes;
+		size_t m_InstanceSize;
+		size_t m_InstanceAlignment;
+		ObjectPool::DestroyFunction m_Destroy;
 	};
 
 	template <typename Type, typename ...Args>
 	class ConstructorImplementation : public Constructor
 	{
 	public:
-		ConstructorImplementation() : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }) {}
+		ConstructorImplementation() : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }, sizeof(Type), alignof(Type), &Details::DestroyInstance<Type>) {}
 
 	private:
-		Any NewInstanceImplementation(std::vector<Any>& args) const override
+		Any NewInstanceImplementation(AnyRef* args) const override
 		{
-			return NewInstanceImplementation(args, std::make_index_sequence<sizeof...(Args)>());
+			auto create = [](auto&&... arguments) { return Type(std::forward<decltype(arguments)>(arguments)...); };
+			return Details::Construction<Args...>::Create(args, create);
 		}
 
-		template <size_t... indices>
-		Any NewInstanceImplementation(std::vector<Any>& args, std::index_sequence<indices...> indexSequence) const
+		bool NewInstancesAtImplementation(void* const* storage, size_t count, AnyRef* args) const override
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-
-			if ((std::get<indices>(argsTuple) && ...))
-			{
-				return Type(*std::get<indices>(argsTuple)...);
-			}
-
-			return Any();
+			return Details::Construction<Args...>::ConstructAt(storage, count, args, [](void* instance, auto&&... arguments) { new (instance) Type(std::forward<decltype(arguments)>(arguments)...); }, &Details::DestroyInstance<Type>);
 		}
 	};
 
@@ -127,28 +340,45 @@ namespace RTTI
 	private:
 		typedef Type(*FreeFunction)(Args...);
 
+		// Only factories returning the type itself by value can construct in place.
+		static constexpr bool IsInPlace = std::is_same_v<Type, Details::RawType<Type>>;
+
 	public:
-		FreeFunctionConstructor(FreeFunction freeFunction) : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }), m_FreeFunction(freeFunction) {}
+		FreeFunctionConstructor(FreeFunction freeFunction)
+			: Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }, IsInPlace ? sizeof(Type) : 0, IsInPlace ? alignof(Type) : 0, GetDestroyFunction()),
+			  m_FreeFunction(freeFunction) {}
 	
 	private:
-		Any NewInstanceImplementation(std::vector<Any>& args) const override
+		static ObjectPool::DestroyFunction GetDestroyFunction()
 		{
-			return NewInstanceImpl(args, std::make_index_sequence<sizeof...(Args)>());
+			if constexpr (IsInPlace)
+			{
+				return &Details::DestroyInstance<Type>;
+			}
+			else
+			{
+				return nullptr;
+			}
 		}
 
-		template <size_t ...indices>
-		Any NewInstanceImplementation(std::vector<Any>& args, std::index_sequence<indices...> indexSequence) const
+		Any NewInstanceImplementation(AnyRef* args) const override
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			FreeFunction freeFunction = m_FreeFunction;
+			auto create = [freeFunction](auto&&... arguments) -> Type { return freeFunction(std::forward<decltype(arguments)>(arguments)...); };
+			return Details::Construction<Args...>::Create(args, create);
+		}
 
-			if ((std::get<indices>(argsTuple) && ...))
+		bool NewInstancesAtImplementation(void* const* storage, size_t count, AnyRef* args) const override
+		{
+			if constexpr (IsInPlace)
 			{
-				return m_FreeFunction(*std::get<indices>(argsTuple)...);
+				FreeFunction freeFunction = m_FreeFunction;
+				return Details::Construction<Args...>::ConstructAt(storage, count, args, [freeFunction](void* instance, auto&&... arguments) { new (instance) Type(freeFunction(std::forward<decltype(arguments)>(arguments)...)); }, &Details::DestroyInstance<Type>);
+			}
+			else
+			{
+				return false;
 			}
-
-			return Any();
 		}
 		
 	private:
@@ -33,6 +33,21 @@ namespace RTTI
 			return static_cast<To>(*static_cast<const From*>(object));
 		}
 	};
+
+	namespace Details
+	{
+		inline Any ConvertInstance(const void* instance, const TypeDescriptor* type, const TypeDescriptor* target)
+		{
+			if (!instance)
+			{
+				return Any();
+			}
+
+			Conversion* conversion = type->GetConversionPath(target).m_Conversion;
+
+			return conversion ? conversion->Convert(instance) : Any();
+		}
+	}
 }
 
 #endif // CONVERSION_H
\ No newline at end of file
@@ -0,0 +1,212 @@
+#ifndef CONVERSION_CACHE_H
+#define CONVERSION_CACHE_H
+
+#include "Epoch.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace RTTI
+{
+	class TypeDescriptor;
+	class Base;
+	class Conversion;
+
+	// How a value of one type becomes a value of another: in place through one of its bases, or by value through a registered conversion. Both are null when there is no way.
+	struct ConversionPath
+	{
+		Base* m_Base = nullptr;
+		Conversion* m_Conversion = nullptr;
+
+		explicit operator bool() const { return m_Base || m_Conversion; }
+	};
+
+	namespace Details
+	{
+		// Remembers the conversion paths from one type to the types it has been asked about, misses included. Lookups are a lock free probe of an
+		// open addressed table, so any number of threads may read while entries are being filled in. The table doubles once half full, so misses
+		// never crowd out paths, and is swapped in whole, the old one being retired like any other published data.
+		class ConversionCache
+		{
+		public:
+			static constexpr size_t InitialCapacity = 16;  // Power of two.
+
+			ConversionCache() = default;
+			ConversionCache(const ConversionCache&) {}  // Copies start out empty, as they are made for tables about to change.
+			ConversionCache& operator=(const ConversionCache&) = delete;
+			~ConversionCache() { delete m_Table.load(std::memory_order_relaxed); }
+
+			// Within a read section.
+			bool Find(const TypeDescriptor* to, ConversionPath& path) const
+			{
+				const Table* table = m_Table.load(std::memory_order_acquire);
+				if (!table)
+				{
+					return false;
+				}
+
+				for (size_t i = GetSlot(to, table->m_Capacity), probes = 0; probes < table->m_Capacity; i = (i + 1) & (table->m_Capacity - 1), ++probes)
+				{
+					const TypeDescriptor* key = table->m_Entries[i].m_To.load(std::memory_order_acquire);
+					if (!key)
+					{
+						return false;
+					}
+
+					if (key == to)
+					{
+						return Decode(table->m_Entries[i].m_Path.load(std::memory_order_acquire), path);  // Fails while the claiming thread has yet to publish.
+					}
+				}
+
+				return false;
+			}
+
+			// Within a read section.
+			void Insert(const TypeDescriptor* to, const ConversionPath& path)
+			{
+				Table* table = m_Table.load(std::memory_order_acquire);
+				if (!table)
+				{
+					Table* firstTable = new Table(InitialCapacity);
+					if (m_Table.compare_exchange_strong(table, firstTable, std::memory_order_acq_rel))
+					{
+						table = firstTable;
+					}
+					else
+					{
+						delete firstTable;  // Never published.
+					}
+				}
+
+				for (size_t i = GetSlot(to, table->m_Capacity), probes = 0; probes < table->m_Capacity; i = (i + 1) & (table->m_Capacity - 1), ++probes)
+				{
+					const TypeDescriptor* key = nullptr;
+					if (table->m_Entries[i].m_To.compare_exchange_strong(key, to, std::memory_order_acq_rel) || key == to)
+					{
+						table->m_Entries[i].m_Path.store(Encode(path), std::memory_order_release);  // Racing threads compute the same path, so the last store is as good as the first.
+
+						if (!key && (table->m_Count.fetch_add(1, std::memory_order_relaxed) + 1) * 2 > table->m_Capacity)
+						{
+							Grow(table);
+						}
+
+						return;
+					}
+				}
+			}
+
+		private:
+			// Paths are packed into a tagged pointer so that they publish with a single store. Base and Conversion are polymorphic, so their low bits are free.
+			enum Tag : uintptr_t
+			{
+				Pending = 0,
+				None = 1,
+				ThroughBase = 2,
+				ThroughConversion = 3,
+				TagMask = 3
+			};
+
+			static uintptr_t Encode(const ConversionPath& path)
+			{
+				if (path.m_Base)
+				{
+					return reinterpret_cast<uintptr_t>(path.m_Base) | ThroughBase;
+				}
+
+				if (path.m_Conversion)
+				{
+					return reinterpret_cast<uintptr_t>(path.m_Conversion) | ThroughConversion;
+				}
+
+				return None;
+			}
+
+			static bool Decode(uintptr_t encoded, ConversionPath& path)
+			{
+				const uintptr_t pointer = encoded & ~uintptr_t(TagMask);
+
+				switch (encoded & TagMask)
+				{
+				case None:
+					path = ConversionPath();
+					return true;
+
+				case ThroughBase:
+					path = { reinterpret_cast<Base*>(pointer), nullptr };
+					return true;
+
+				case ThroughConversion:
+					path = { nullptr, reinterpret_cast<Conversion*>(pointer) };
+					return true;
+
+				default:
+					return false;
+				}
+			}
+
+			static size_t GetSlot(const TypeDescriptor* to, size_t capacity)
+			{
+				return static_cast<size_t>((static_cast<uint64_t>(reinterpret_cast<uintptr_t>(to)) * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+			}
+
+		private:
+			struct Entry
+			{
+				std::atomic<const TypeDescriptor*> m_To{ nullptr };
+				std::atomic<uintptr_t> m_Path{ Pending };
+			};
+
+			struct Table
+			{
+				explicit Table(size_t capacity) : m_Capacity(capacity), m_Entries(new Entry[capacity]) {}
+
+				const size_t m_Capacity;
+				std::unique_ptr<Entry[]> m_Entries;
+				std::atomic<size_t> m_Count{ 0 };
+			};
+
+			// Copies the settled entries of a full table into one twice its size. Entries still being filled in are dropped, to be worked out again.
+			void Grow(const Table* fullTable)
+			{
+				std::lock_guard<std::recursive_mutex> lock(GetRegistrationMutex());
+
+				if (m_Table.load(std::memory_order_acquire) != fullTable)
+				{
+					return;  // Another thread grew it first.
+				}
+
+				Table* table = new Table(fullTable->m_Capacity * 2);
+				for (size_t i = 0; i < fullTable->m_Capacity; ++i)
+				{
+					const TypeDescriptor* to = fullTable->m_Entries[i].m_To.load(std::memory_order_acquire);
+					const uintptr_t encoded = fullTable->m_Entries[i].m_Path.load(std::memory_order_acquire);
+					if (!to || encoded == Pending)
+					{
+						continue;
+					}
+
+					size_t slot = GetSlot(to, table->m_Capacity);
+					while (table->m_Entries[slot].m_To.load(std::memory_order_relaxed))
+					{
+						slot = (slot + 1) & (table->m_Capacity - 1);
+					}
+
+					table->m_Entries[slot].m_To.store(to, std::memory_order_relaxed);
+					table->m_Entries[slot].m_Path.store(encoded, std::memory_order_relaxed);
+					table->m_Count.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				// Readers may still be probing the old table, so it is retired rather than deleted.
+				m_Table.store(table, std::memory_order_release);
+				EpochDomain::GetInstance().Retire(fullTable);
+			}
+
+			std::atomic<Table*> m_Table{ nullptr };
+		};
+	}
+}
+
+#endif
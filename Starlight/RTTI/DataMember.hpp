@@ -7,77 +7,265 @@
 
 namespace RTTI
 {
+	namespace Details
+	{
+		// One per type, cv qualifiers and pointers included, unlike type descriptors. Used where values are copied as raw memory.
+		// Writable, so that identical data folding can't merge the variables of different types, whatever the linker settings.
+		template <typename T>
+		inline char g_TypeIdentity = 0;
+
+		template <typename T>
+		constexpr const void* GetTypeIdentity()
+		{
+			return &g_TypeIdentity<std::remove_cv_t<T>>;
+		}
+	}
+
 	class DataMember
 	{
 	public:
-		std::string GetName() const { return m_Name; }
+		std::string_view GetName() const { return m_Name.GetName(); }
+		const HashedName& GetHashedName() const { return m_Name; }
 		const TypeDescriptor* GetParent() const { return m_DataClass; }
 		const TypeDescriptor* GetType() const { return m_DataType; }
 
-		virtual void Set(AnyRef objectReference, const Any value) = 0;
-		virtual Any Get(Any object) = 0;
+		// Plain data members of standard layout classes sit at a fixed offset within their object, so their bytes can be read without going through Any.
+		// Stride is the size of the owning class, i.e. the distance between the member in consecutive elements of an array of objects.
+		bool HasOffset() const { return m_HasOffset; }
+		size_t GetOffset() const { return m_Offset; }
+		size_t GetSize() const { return m_Size; }
+		size_t GetStride() const { return m_Stride; }
+
+		// value is converted if its type differs from the member's.
+		virtual void Set(AnyRef object, AnyRef value) = 0;
+
+		template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, AnyRef>>>
+		void Set(AnyRef object, T&& value)
+		{
+			auto&& decayedValue = Details::DecayArray(value);
+			Set(object, AnyRef(decayedValue));
+		}
+
+		// Copies the member's value.
+		virtual Any Get(AnyRef object) = 0;
+
+		// Refers to the member in place without copying it. Empty if the member is only reachable through a getter that returns by value.
+		virtual AnyRef GetRef(AnyRef object) = 0;
+
+		/*
+			Batch access. T must be exactly the member's type, as values are copied directly rather than boxed in Any. The type is checked once per
+			call instead of once per object, and the copy is a plain loop over the objects. No conversions are made. values holds count elements.
+		*/
+		template <typename T>
+		void GetMany(const AnyRef* objects, size_t count, T* values)
+		{
+			CheckBatchType<T>();
+			GetManyImpl(objects, count, values);
+		}
+
+		template <typename T>
+		void SetMany(const AnyRef* objects, size_t count, const T* values)
+		{
+			CheckBatchType<T>();
+			SetManyImpl(objects, count, values);
+		}
+
+		// As above, for objects in contiguous memory. Object must be the member's class or derive from it. stride defaults to sizeof(Object).
+		template <typename Object, typename T, typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<Object>, AnyRef>>>
+		void GetMany(const Object* objects, size_t count, T* values, size_t stride = sizeof(Object))
+		{
+			CheckBatchType<T>();
+			GetStridedImpl(CastFirstObject(objects, count), stride, count, values);
+		}
+
+		template <typename Object, typename T, typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<Object>, AnyRef>>>
+		void SetMany(Object* objects, size_t count, const T* values, size_t stride = sizeof(Object))
+		{
+			CheckBatchType<T>();
+			SetStridedImpl(CastFirstObject(objects, count), stride, count, values);
+		}
 
 	protected:
-		DataMember(const std::string &name, const TypeDescriptor *type, const TypeDescriptor *parent)
-			     : m_Name(name), m_DataType(type), m_DataClass(parent) { }
+		DataMember(const HashedName &name, const TypeDescriptor *type, const TypeDescriptor *parent, const void *typeIdentity, size_t size, size_t stride, bool hasOffset = false, size_t offset = 0)
+			     : m_Name(name), m_DataType(type), m_DataClass(parent), m_TypeIdentity(typeIdentity), m_Offset(offset), m_Size(size), m_Stride(stride), m_HasOffset(hasOffset) { }
+
+		// values points at count elements of the member's type. The strided variants receive the first object already cast to the member's class.
+		virtual void GetManyImpl(const AnyRef* objects, size_t count, void* values) = 0;
+		virtual void SetManyImpl(const AnyRef* objects, size_t count, const void* values) = 0;
+		virtual void GetStridedImpl(const void* firstObject, size_t stride, size_t count, void* values) = 0;
+		virtual void SetStridedImpl(void* firstObject, size_t stride, size_t count, const void* values) = 0;
+
+	private:
+		template <typename T>
+		void CheckBatchType() const
+		{
+			if (Details::GetTypeIdentity<T>() != m_TypeIdentity)
+			{
+				throw BadCastException(Details::Resolve<T>()->GetName(), m_DataType->GetName(), "values:");
+			}
+		}
+
+		// Bases are at the same offset in every element, so only the first object needs casting.
+		template <typename Object>
+		void* CastFirstObject(const Object* objects, size_t count) const
+		{
+			void* firstObject = Details::CastInstance(const_cast<void*>(static_cast<const void*>(objects)), Details::Resolve<Object>(), m_DataClass);
+
+			if (!firstObject && count > 0)
+			{
+				throw BadCastException(m_DataClass->GetName(), Details::Resolve<Object>()->GetName(), "objects:");
+			}
+
+			return firstObject;
+		}
 
 	private:
-		std::string m_Name;                 
+		HashedName m_Name;
 		const TypeDescriptor* m_DataType;    // Type of the data member.
 		const TypeDescriptor* m_DataClass;   // Type of the data member's class
+		const void* m_TypeIdentity;          // Exact type of the data member, for batch access.
+
+		size_t m_Offset;
+		size_t m_Size;
+		size_t m_Stride;
+		bool m_HasOffset;
 	};
 
+	namespace Details
+	{
+		// Offset of a member from the start of its object, for standard layout classes only. The object is never constructed or read, only its address is used.
+		template <typename Class, typename Type>
+		size_t GetMemberOffset(Type Class::*dataMemberPtr)
+		{
+			if constexpr (std::is_standard_layout_v<Class>)
+			{
+				union Storage
+				{
+					Storage() {}
+					~Storage() {}
+
+					Class m_Object;
+				} storage;
+
+				return static_cast<size_t>(reinterpret_cast<const unsigned char*>(&(storage.m_Object.*dataMemberPtr)) - reinterpret_cast<const unsigned char*>(&storage.m_Object));
+			}
+			else
+			{
+				return 0;
+			}
+		}
+	}
+
 	template <typename Class, typename Type>
 	class PtrDataMember : public DataMember
 	{
 	public:
-		PtrDataMember(Type Class::*dataMemberPtr, const std::string name)
-			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>()), mDataMemberPtr(dataMemberPtr) {}
+		PtrDataMember(Type Class::*dataMemberPtr, const HashedName& name)
+			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>(), Details::GetTypeIdentity<Type>(), sizeof(Type), sizeof(Class), std::is_standard_layout_v<Class>, Details::GetMemberOffset(dataMemberPtr)),
+			  mDataMemberPtr(dataMemberPtr) {}
 
-		void Set(AnyRef objectRef, const Any value) override
+		using DataMember::Set;
+
+		void Set(AnyRef objectRef, AnyRef value) override
 		{
 			SetImpl(objectRef, value, std::is_const<Type>());  // use tag dispatch
 		}
 
-		Any Get(Any object) override
+		Any Get(AnyRef object) override
 		{
-			Class *obj = object.TryCast<Class>();
+			return *GetMember(object);
+		}
 
-			if (!obj)
+		AnyRef GetRef(AnyRef object) override
+		{
+			return AnyRef(*GetMember(object));
+		}
+
+	protected:
+		using ValueType = std::remove_cv_t<Type>;
+
+		void GetManyImpl(const AnyRef* objects, size_t count, void* values) override
+		{
+			ValueType* out = static_cast<ValueType*>(values);
+
+			for (size_t i = 0; i < count; ++i)
 			{
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName());
+				out[i] = *GetMember(objects[i]);
 			}
+		}
+
+		void SetManyImpl(const AnyRef* objects, size_t count, const void* values) override
+		{
+			if constexpr (!std::is_const_v<Type>)
+			{
+				const ValueType* in = static_cast<const ValueType*>(values);
 
-			return obj->*mDataMemberPtr;
+				for (size_t i = 0; i < count; ++i)
+				{
+					*GetMember(objects[i]) = in[i];
+				}
+			}
+		}
+
+		void GetStridedImpl(const void* firstObject, size_t stride, size_t count, void* values) override
+		{
+			const unsigned char* object = static_cast<const unsigned char*>(firstObject);
+			ValueType* out = static_cast<ValueType*>(values);
+
+			for (size_t i = 0; i < count; ++i, object += stride)
+			{
+				out[i] = reinterpret_cast<const Class*>(object)->*mDataMemberPtr;
+			}
+		}
+
+		void SetStridedImpl(void* firstObject, size_t stride, size_t count, const void* values) override
+		{
+			if constexpr (!std::is_const_v<Type>)
+			{
+				unsigned char* object = static_cast<unsigned char*>(firstObject);
+				const ValueType* in = static_cast<const ValueType*>(values);
+
+				for (size_t i = 0; i < count; ++i, object += stride)
+				{
+					reinterpret_cast<Class*>(object)->*mDataMemberPtr = in[i];
+				}
+			}
 		}
 
 	private:
 		Type Class::*mDataMemberPtr;
 
 	private:
-		// Use tag dispatch.
-		void SetImpl(Any object, const Any value, std::false_type)
+		Type* GetMember(AnyRef object) const
 		{
 			Class *obj = object.TryCast<Class>();  // pointers to members of base class can be used with derived class
 
 			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName(), "object:");
-
-			Type const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<Type>(); !casted)
 			{
-				val = value.TryConvert<Type>();
-				casted = val.TryCast<Type>();
+				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType() ? object.GetType()->GetName() : "nothing");
 			}
 
+			return &(obj->*mDataMemberPtr);
+		}
+
+		// Use tag dispatch.
+		void SetImpl(AnyRef object, AnyRef value, std::false_type)
+		{
+			Class *obj = object.TryCast<Class>();
+
+			if (!obj)
+				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType() ? object.GetType()->GetName() : "nothing", "object:");
+
+			Any converted;
+			Type const *casted = Details::CastOrConvert<const Type>(value, converted);
+
 			if (!casted)
-				throw BadCastException(Details::Resolve<Type>()->GetName(), value.GetType()->GetName(), "value:");
+				throw BadCastException(Details::Resolve<Type>()->GetName(), value.GetType() ? value.GetType()->GetName() : "nothing", "value:");
 
 			obj->*mDataMemberPtr = *casted;
 		}
 
-		void SetImpl(Any object, const Any value, std::true_type)
+		void SetImpl(AnyRef object, AnyRef value, std::true_type)
 		{
 			//static_assert(false, "can't set const data member");
 		}
@@ -107,56 +295,119 @@ namespace RTTI
 	class SetGetDataMember : public DataMember
 	{
 	private:
-		using MemberType = Details::RawType<typename decltype(ToFunctionHelper(Getter))::ReturnType>;
+		using ReturnType = typename decltype(ToFunctionHelper(Getter))::ReturnType;
+		using MemberType = Details::RawType<ReturnType>;
 
 	public:
-		SetGetDataMember(const std::string name) : DataMember(name, Details::Resolve<MemberType>(), Details::Resolve<Class>()) {}
+		SetGetDataMember(const HashedName& name) : DataMember(name, Details::Resolve<MemberType>(), Details::Resolve<Class>(), Details::GetTypeIdentity<MemberType>(), sizeof(MemberType), sizeof(Class)) {}
 
-		void Set(AnyRef objectRef, const Any value) override
+		using DataMember::Set;
+
+		void Set(AnyRef objectRef, AnyRef value) override
 		{
-			Any a = objectRef;
-			Class *obj = a.TryCast<Class>();
+			Class *obj = GetObject(objectRef, "object:");
 
-			if (!obj)
+			Any converted;
+			MemberType const *casted = Details::CastOrConvert<const MemberType>(value, converted);
+
+			if (!casted)
 			{
-				throw BadCastException(Details::Resolve<Class>()->GetName(), Any(objectRef).GetType()->GetName(), "object:");
+				throw BadCastException(Details::Resolve<MemberType>()->GetName(), value.GetType() ? value.GetType()->GetName() : "nothing", "value:");
 			}
 
-			MemberType const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<MemberType>(); !casted)
+			CallSetter(obj, *casted);
+		}
+
+		Any Get(AnyRef object) override
+		{
+			return CallGetter(GetObject(object));
+		}
+
+		AnyRef GetRef(AnyRef object) override
+		{
+			if constexpr (std::is_lvalue_reference_v<ReturnType>)
 			{
-				val = value.TryConvert<MemberType>();
-				casted = val.TryCast<MemberType>();
+				return AnyRef(CallGetter(GetObject(object)));
 			}
+			else
+			{
+				return AnyRef();
+			}
+		}
 
-			if (!casted)
+	protected:
+		void GetManyImpl(const AnyRef* objects, size_t count, void* values) override
+		{
+			MemberType* out = static_cast<MemberType*>(values);
+
+			for (size_t i = 0; i < count; ++i)
 			{
-				throw BadCastException(Details::Resolve<MemberType>()->GetName(), value.GetType()->GetName(), "value:");
+				out[i] = CallGetter(GetObject(objects[i]));
 			}
+		}
 
-			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
+		void SetManyImpl(const AnyRef* objects, size_t count, const void* values) override
+		{
+			const MemberType* in = static_cast<const MemberType*>(values);
+
+			for (size_t i = 0; i < count; ++i)
 			{
-				(obj->*Setter)(*casted);
+				CallSetter(GetObject(objects[i], "object:"), in[i]);
 			}
-			else
+		}
+
+		void GetStridedImpl(const void* firstObject, size_t stride, size_t count, void* values) override
+		{
+			const unsigned char* object = static_cast<const unsigned char*>(firstObject);
+			MemberType* out = static_cast<MemberType*>(values);
+
+			for (size_t i = 0; i < count; ++i, object += stride)
 			{
-				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Setter)>>);
+				out[i] = CallGetter(reinterpret_cast<Class*>(const_cast<unsigned char*>(object)));
+			}
+		}
 
-				Setter(*obj, *casted);
+		void SetStridedImpl(void* firstObject, size_t stride, size_t count, const void* values) override
+		{
+			unsigned char* object = static_cast<unsigned char*>(firstObject);
+			const MemberType* in = static_cast<const MemberType*>(values);
+
+			for (size_t i = 0; i < count; ++i, object += stride)
+			{
+				CallSetter(reinterpret_cast<Class*>(object), in[i]);
 			}
 		}
 
-		Any Get(Any object) override
+	private:
+		Class* GetObject(AnyRef object, const std::string& message = "") const
 		{
 			Class *obj = object.TryCast<Class>();
 
 			if (!obj)
 			{
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName());
+				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType() ? object.GetType()->GetName() : "nothing", message);
 			}
 
+			return obj;
+		}
+
+		static void CallSetter(Class* obj, const MemberType& value)
+		{
 			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
+			{
+				(obj->*Setter)(value);
+			}
+			else
+			{
+				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Setter)>>);
+
+				Setter(*obj, value);
+			}
+		}
+
+		static ReturnType CallGetter(Class* obj)
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Getter)>)
 			{
 				return (obj->*Getter)();
 			}
@@ -0,0 +1,221 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+/*
+	Read-copy-update for reflection data. Registration never changes data readers can see. It copies it, changes the copy, and swaps the copy in.
+	The old version is retired, and deleted once every thread that could still be reading it has left its read section.
+
+	Readers mark a read section by writing the current epoch into a slot of their own, so lookups from any number of threads never lock or share a
+	written cache line. Writers serialize on the registration mutex, and reclaim what they can each time they retire something.
+*/
+
+namespace RTTI
+{
+	namespace Details
+	{
+		class EpochDomain
+		{
+		public:
+			static EpochDomain& GetInstance()
+			{
+				static EpochDomain epochDomain;
+
+				return epochDomain;
+			}
+
+			EpochDomain(const EpochDomain&) = delete;
+			EpochDomain& operator=(const EpochDomain&) = delete;
+
+			~EpochDomain()
+			{
+				for (const Retired& retired : m_Retired)
+				{
+					retired.m_Deleter(retired.m_Object);
+				}
+			}
+
+			// Read sections nest. Only the outermost one announces an epoch.
+			void Enter()
+			{
+				ThreadRecord* threadRecord = GetThreadRecord();
+
+				if (threadRecord->m_Depth++ == 0)
+				{
+					threadRecord->m_Epoch.store(m_Epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+				}
+			}
+
+			void Leave()
+			{
+				ThreadRecord* threadRecord = GetThreadRecord();
+
+				if (--threadRecord->m_Depth == 0)
+				{
+					threadRecord->m_Epoch.store(Idle, std::memory_order_release);
+				}
+			}
+
+			// Writers only, with the registration mutex held. The object must already be unreachable for new readers.
+			template <typename T>
+			void Retire(const T* object)
+			{
+				m_Retired.push_back({ const_cast<T*>(object), [](void* retiredObject) { delete static_cast<T*>(retiredObject); }, m_Epoch.fetch_add(1, std::memory_order_seq_cst) });
+
+				Reclaim();
+			}
+
+		private:
+			static constexpr uint64_t Idle = std::numeric_limits<uint64_t>::max();
+
+			// One per thread, padded so that readers never share a cache line. Records are recycled when their threads exit, and never freed.
+			struct alignas(64) ThreadRecord
+			{
+				std::atomic<uint64_t> m_Epoch{ Idle };
+				std::atomic<bool> m_IsInUse{ true };
+				ThreadRecord* m_Next = nullptr;
+				uint32_t m_Depth = 0;  // Only touched by the owning thread.
+			};
+
+			struct ThreadRecordOwner
+			{
+				ThreadRecord* m_ThreadRecord = nullptr;
+
+				~ThreadRecordOwner()
+				{
+					if (m_ThreadRecord)
+					{
+						m_ThreadRecord->m_Epoch.store(Idle, std::memory_order_release);
+						m_ThreadRecord->m_IsInUse.store(false, std::memory_order_release);
+					}
+				}
+			};
+
+			struct Retired
+			{
+				void* m_Object;
+				void (*m_Deleter)(void*);
+				uint64_t m_Epoch;  // Readers that announced this epoch or an earlier one may still hold the object.
+			};
+
+			EpochDomain() = default;
+
+			ThreadRecord* GetThreadRecord()
+			{
+				thread_local ThreadRecordOwner threadRecordOwner;
+
+				if (!threadRecordOwner.m_ThreadRecord)
+				{
+					threadRecordOwner.m_ThreadRecord = AcquireThreadRecord();
+				}
+
+				return threadRecordOwner.m_ThreadRecord;
+			}
+
+			ThreadRecord* AcquireThreadRecord()
+			{
+				for (ThreadRecord* threadRecord = m_ThreadRecords.load(std::memory_order_acquire); threadRecord; threadRecord = threadRecord->m_Next)
+				{
+					bool isInUse = false;
+					if (threadRecord->m_IsInUse.compare_exchange_strong(isInUse, true, std::memory_order_acq_rel))
+					{
+						return threadRecord;
+					}
+				}
+
+				ThreadRecord* threadRecord = new ThreadRecord;
+				threadRecord->m_Next = m_ThreadRecords.load(std::memory_order_relaxed);
+				while (!m_ThreadRecords.compare_exchange_weak(threadRecord->m_Next, threadRecord, std::memory_order_acq_rel));
+
+				return threadRecord;
+			}
+
+			void Reclaim()
+			{
+				uint64_t oldestEpoch = Idle;
+				for (ThreadRecord* threadRecord = m_ThreadRecords.load(std::memory_order_acquire); threadRecord; threadRecord = threadRecord->m_Next)
+				{
+					const uint64_t epoch = threadRecord->m_Epoch.load(std::memory_order_seq_cst);
+					oldestEpoch = epoch < oldestEpoch ? epoch : oldestEpoch;
+				}
+
+				size_t kept = 0;
+				for (const Retired& retired : m_Retired)
+				{
+					if (retired.m_Epoch < oldestEpoch)
+					{
+						retired.m_Deleter(retired.m_Object);
+					}
+					else
+					{
+						m_Retired[kept++] = retired;
+					}
+				}
+
+				m_Retired.resize(kept);
+			}
+
+		private:
+			std::atomic<uint64_t> m_Epoch{ 0 };
+			std::atomic<ThreadRecord*> m_ThreadRecords{ nullptr };
+			std::vector<Retired> m_Retired;  // Guarded by the registration mutex.
+		};
+
+		// Serializes registration. Recursive, as registering one type can resolve, and so build, another.
+		inline std::recursive_mutex& GetRegistrationMutex()
+		{
+			static std::recursive_mutex registrationMutex;
+
+			return registrationMutex;
+		}
+
+		// A value published for lock free reading. Load within a read section. Update with the registration mutex held.
+		template <typename T>
+		class Published
+		{
+		public:
+			Published() : m_Current(new T()) {}
+			~Published() { delete m_Current.load(std::memory_order_relaxed); }
+
+			Published(const Published&) = delete;
+			Published& operator=(const Published&) = delete;
+
+			const T& Load() const
+			{
+				return *m_Current.load(std::memory_order_seq_cst);
+			}
+
+			// Applies update to a copy of the current value, then publishes the copy.
+			template <typename Updater>
+			void Update(Updater&& update)
+			{
+				T* next = new T(*m_Current.load(std::memory_order_relaxed));
+				update(*next);
+
+				EpochDomain::GetInstance().Retire(m_Current.exchange(next, std::memory_order_seq_cst));
+			}
+
+		private:
+			std::atomic<const T*> m_Current;
+		};
+	}
+
+	// A read section. Every lookup opens one of its own, and TypeDescriptor returns copies or objects that are never freed, so this is only
+	// needed when reading a Published value's Load() directly, to keep it alive while other threads may replace it.
+	class ReadGuard
+	{
+	public:
+		ReadGuard() { Details::EpochDomain::GetInstance().Enter(); }
+		~ReadGuard() { Details::EpochDomain::GetInstance().Leave(); }
+
+		ReadGuard(const ReadGuard&) = delete;
+		ReadGuard& operator=(const ReadGuard&) = delete;
+	};
+}
+
+#endif
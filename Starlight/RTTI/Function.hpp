@@ -12,26 +12,38 @@ namespace RTTI
 	class Function
 	{
 	public:
-		std::string GetName() const { return m_Name; }
+		static constexpr size_t MaxParameterCount = 16;  // Arguments are gathered on the stack, so the count is bounded.
+
+		std::string_view GetName() const { return m_Name.GetName(); }
+		const HashedName& GetHashedName() const { return m_Name; }
 		const TypeDescriptor* GetParent() const { return m_ParentType; }
 
 		Any Invoke(AnyRef object, std::vector<Any> &args) const
 		{
 			if (args.size() == mParamTypes.size())
 			{
-				return InvokeImpl(object, args);
+				AnyRef argRefs[MaxParameterCount];
+				for (size_t i = 0; i < args.size(); ++i)
+				{
+					argRefs[i] = args[i];
+				}
+
+				return m_Invoker(this, object, argRefs);
 			}
 
 			return Any();
 		}
 
+		// Arguments are passed by reference through a stack array. Nothing is copied or allocated unless an argument needs a conversion, or an
+		// rvalue reference parameter receives an lvalue. Only arguments passed here as rvalues are moved from.
 		template <typename... Args>
 		Any Invoke(AnyRef object, Args&&... args) const
 		{
+			static_assert(sizeof...(Args) <= MaxParameterCount, "Too many arguments for a reflected call.");
+
 			if (sizeof...(Args) == mParamTypes.size())
 			{
-				std::vector<Any> anyArgs{ Any(std::forward<Args>(args))... };
-				return InvokeImpl(object, anyArgs);
+				return InvokeWithReferences(object, Details::DecayArray(std::forward<Args>(args))...);
 			}
 
 			return Any();
@@ -58,97 +70,145 @@ namespace RTTI
 		}
 
 	protected:
-		Function(const std::string& name, const TypeDescriptor* parent, const TypeDescriptor* returnType, const std::vector<const TypeDescriptor*> paramTypes)
-			: m_Name(name), m_ParentType(parent), m_ReturnType(returnType), mParamTypes(paramTypes) {}
+		// Generated per signature. Receives the function itself, the object (ignored by free functions) and exactly GetParameterCount() arguments.
+		using Invoker = Any(*)(const Function*, AnyRef, AnyRef*);
+
+		Function(const HashedName& name, const TypeDescriptor* parent, const TypeDescriptor* returnType, const std::vector<const TypeDescriptor*> paramTypes, Invoker invoker)
+			: m_Name(name), m_ParentType(parent), m_ReturnType(returnType), mParamTypes(paramTypes), m_Invoker(invoker) {}
 
 	protected:
 		const TypeDescriptor* m_ReturnType;
 		std::vector<const TypeDescriptor*> mParamTypes;
 
 	private:
-		virtual Any InvokeImpl(Any object, std::vector<Any> &args) const = 0;
+		template <typename... Args>
+		Any InvokeWithReferences(AnyRef object, Args&&... args) const
+		{
+			AnyRef argRefs[sizeof...(Args) + 1] = { AnyRef::ForwardRef<Args>(args)... };
+			return m_Invoker(this, object, argRefs);
+		}
 
 	private:
-		std::string m_Name;
+		HashedName m_Name;
 		const TypeDescriptor* const m_ParentType;
+		Invoker m_Invoker;
 	};
 
-
-	template <typename Ret, typename... Args>
-	class FreeFunction : public Function
+	namespace Details
 	{
-	private:
-		using FunPtr = Ret(*)(Args...);
+		template <typename T>
+		using ParameterType = std::remove_cv_t<std::remove_reference_t<T>>;
+
+		/*
+			Casts, or converts, an argument for a parameter of type T. Returns nullptr if it doesn't fit, which includes a const argument for a
+			non-const reference. Rvalue reference parameters get a copy in storage unless the argument may be moved from, so PassArgument only
+			ever moves from the caller's rvalues or from storage.
+		*/
+		template <typename T>
+		ParameterType<T>* GetArgument(AnyRef argument, Any& storage)
+		{
+			using Parameter = ParameterType<T>;
 
-	public:
-		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mFreeFunPtr(freeFunPtr) {}
+			if constexpr (std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>)
+			{
+				if (argument.IsConst())
+				{
+					return nullptr;
+				}
+			}
 
-	private:
-		Any InvokeImpl(Any, std::vector<Any> &args) const override
+			Parameter* casted = CastOrConvert<Parameter>(argument, storage);
+
+			if constexpr (std::is_rvalue_reference_v<T>)
+			{
+				if (casted && !storage && !argument.IsMovable())
+				{
+					if constexpr (std::is_copy_constructible_v<Parameter>)
+					{
+						storage = static_cast<const Parameter&>(*casted);
+						return storage.TryCast<Parameter>();
+					}
+					else
+					{
+						return nullptr;
+					}
+				}
+			}
+
+			return casted;
+		}
+
+		// Rvalue reference parameters are moved into, every other parameter binds to or copies from the argument.
+		template <typename T>
+		decltype(auto) PassArgument(ParameterType<T>* argument)
 		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
+			if constexpr (std::is_rvalue_reference_v<T>)
+			{
+				return std::move(*argument);
+			}
+			else
+			{
+				return (*argument);
+			}
 		}
 
-		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		template <typename Ret, typename... Args>
+		struct Invocation
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			static_assert(sizeof...(Args) <= Function::MaxParameterCount, "Too many parameters for a reflected function.");
 
-			if ((std::get<indices>(argsTuple) && ...))  // all arguments are valid
+			// Casts every argument, then hands them to call. Returns an empty Any if any argument is incompatible.
+			template <typename Call>
+			static Any Invoke(AnyRef* args, Call&& call)
 			{
-				if constexpr (std::is_reference_v<Ret>)
+				return Invoke(args, call, std::index_sequence_for<Args...>());
+			}
+
+			template <typename Call, size_t... indices>
+			static Any Invoke([[maybe_unused]] AnyRef* args, Call& call, std::index_sequence<indices...>)
+			{
+				[[maybe_unused]] Any convertedArgs[sizeof...(Args) + 1];
+				std::tuple<ParameterType<Args>*...> castedArgs{ GetArgument<Args>(args[indices], convertedArgs[indices])... };
+
+				if (!(std::get<indices>(castedArgs) && ...))
+				{
+					return Any();
+				}
+
+				if constexpr (std::is_void_v<Ret>)
+				{
+					call(PassArgument<Args>(std::get<indices>(castedArgs))...);
+					return Any();
+				}
+				else if constexpr (std::is_reference_v<Ret>)
 				{
-					return AnyRef(mFreeFunPtr(*std::get<indices>(argsTuple)...));
+					return AnyRef(call(PassArgument<Args>(std::get<indices>(castedArgs))...));
 				}
 				else
 				{
-					return mFreeFunPtr(*std::get<indices>(argsTuple)...);
+					return call(PassArgument<Args>(std::get<indices>(castedArgs))...);
 				}
 			}
-			else
-			{
-				return Any();
-			}
-		}
+		};
+	}
 
-	private:
-		FunPtr mFreeFunPtr;
-	};
 
-
-	template <typename... Args>
-	class FreeFunction<void, Args...> : public Function
+	template <typename Ret, typename... Args>
+	class FreeFunction : public Function
 	{
 	private:
-		using FunPtr = void(*)(Args...);
+		using FunPtr = Ret(*)(Args...);
 
 	public:
-		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mFreeFunPtr(freeFunPtr) {}
+		FreeFunction(FunPtr freeFunPtr, const HashedName& name)
+			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }, &Call), mFreeFunPtr(freeFunPtr) {}
 
 	private:
-		Any InvokeImpl(Any, std::vector<Any>& args) const override
-		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
-		}
-
-		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any>& args, std::index_sequence<indices...> indexSequence) const
+		static Any Call(const Function* function, AnyRef, AnyRef* args)
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			FunPtr freeFunPtr = static_cast<const FreeFunction*>(function)->mFreeFunPtr;
 
-			if ((std::get<indices>(argsTuple) && ...))  // All arguments are valid.
-			{
-				mFreeFunPtr(*std::get<indices>(argsTuple)...);
-			}
-
-			return Any();
+			return Details::Invocation<Ret, Args...>::Invoke(args, [freeFunPtr](auto&&... arguments) -> Ret { return freeFunPtr(std::forward<decltype(arguments)>(arguments)...); });
 		}
 
 	private:
@@ -163,73 +223,21 @@ namespace RTTI
 		using MemFunPtr = Ret(C::*)(Args...);
 
 	public:
-		MemberFunction(MemFunPtr memFun, const std::string& name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mMemFunPtr(memFun) {}
+		MemberFunction(MemFunPtr memFun, const HashedName& name)
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }, &Call), mMemFunPtr(memFun) {}
 
 	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
+		static Any Call(const Function* function, AnyRef object, AnyRef* args)
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
-		}
-
-		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
-		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-
-			if (C* obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // Object is valid and all arguments are valid.
-			{
-				if constexpr (std::is_reference_v<Ret>)
-				{
-					return AnyRef((obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...));
-				}
-				else
-				{
-					return (obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
-				}
-			}
-			else
+			C* obj = object.TryCast<C>();
+			if (!obj)
 			{
 				return Any();
 			}
-		}
-
-		MemFunPtr mMemFunPtr;
-	};
 
+			MemFunPtr memFunPtr = static_cast<const MemberFunction*>(function)->mMemFunPtr;
 
-	template <typename C, typename... Args>
-	class MemberFunction<C, void, Args...> : public Function
-	{
-	private:
-		using MemFunPtr = void(C::*)(Args...);
-
-	public:
-		MemberFunction(MemFunPtr memFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mMemFunPtr(memFun) {}
-
-	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
-		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
-		}
-
-		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
-		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-
-			if (C* obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // Object is valid and all arguments are valid.
-			{
-				(obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
-			}
-
-			return Any();
+			return Details::Invocation<Ret, Args...>::Invoke(args, [obj, memFunPtr](auto&&... arguments) -> Ret { return (obj->*memFunPtr)(std::forward<decltype(arguments)>(arguments)...); });
 		}
 
 		MemFunPtr mMemFunPtr;
@@ -243,51 +251,26 @@ namespace RTTI
 		using ConstMemFunPtr = Ret(C::*)(Args...) const;
 
 	public:
-		ConstMemberFunction(ConstMemFunPtr constMemFun, const std::string& name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mConstMemFunPtr(constMemFun) {}
+		ConstMemberFunction(ConstMemFunPtr constMemFun, const HashedName& name)
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }, &Call), mConstMemFunPtr(constMemFun) {}
 
 	private:
-		Any InvokeImpl(Any object, std::vector<Any>& args) const override
+		static Any Call(const Function* function, AnyRef object, AnyRef* args)
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
-		}
-
-		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any>& args, std::index_sequence<indices...> indexSequence) const
-		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-
-			if (C* obj = object.TryCast<C>(); obj && (std::get<indices>(argsTuple) && ...))  // object is valid and all arguments are valid 
-			{
-				if constexpr (std::is_void<Ret>::value)
-				{
-					(obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
-
-					return Any();
-				}
-				else
-				{
-					if constexpr (std::is_reference_v<Ret>)
-					{
-						return AnyRef((obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...));
-					}
-					else
-					{
-						return (obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
-					}
-				}
-			}
-			else
+			const C* obj = object.TryCast<C>();
+			if (!obj)
 			{
 				return Any();
-			}		
+			}
+
+			ConstMemFunPtr constMemFunPtr = static_cast<const ConstMemberFunction*>(function)->mConstMemFunPtr;
+
+			return Details::Invocation<Ret, Args...>::Invoke(args, [obj, constMemFunPtr](auto&&... arguments) -> Ret { return (obj->*constMemFunPtr)(std::forward<decltype(arguments)>(arguments)...); });
 		}
 
 	private:
 		ConstMemFunPtr mConstMemFunPtr;
 	};
-}  
+}
 
-#endif  
\ No newline at end of file
+#endif
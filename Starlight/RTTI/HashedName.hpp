@@ -0,0 +1,175 @@
+#ifndef HASHED_NAME_H
+#define HASHED_NAME_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace RTTI
+{
+	// 64-bit FNV-1a. Names known at compile time are hashed by the compiler.
+	constexpr uint64_t HashName(std::string_view name)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (char character : name)
+		{
+			hash ^= static_cast<uint8_t>(character);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	// A name paired with its precomputed hash. Comparisons check the hash before the characters.
+	class HashedName
+	{
+	public:
+		constexpr HashedName() = default;
+		constexpr explicit HashedName(std::string_view name) : m_Name(name), m_Hash(HashName(name)) { }
+		constexpr explicit HashedName(const char* name) : HashedName(std::string_view(name)) { }
+
+		// Copies the name into a process wide pool so that the returned view never dangles. Equal names share storage. Only registration should need this.
+		static HashedName Intern(std::string_view name)
+		{
+			static std::mutex poolMutex;
+			static std::unordered_set<std::string> namePool;  // Node based, so pooled strings never move.
+
+			std::lock_guard<std::mutex> lock(poolMutex);
+			return HashedName(*namePool.emplace(name).first);
+		}
+
+		constexpr std::string_view GetName() const { return m_Name; }
+		constexpr uint64_t GetHash() const { return m_Hash; }
+
+		constexpr bool operator==(const HashedName& other) const { return m_Hash == other.m_Hash && m_Name == other.m_Name; }
+		constexpr bool operator!=(const HashedName& other) const { return !(*this == other); }
+
+	private:
+		std::string_view m_Name;
+		uint64_t m_Hash = HashName("");
+	};
+
+	// Open addressing table from names to reflection objects. Lookups hash once and probe a flat array, without allocating.
+	template <typename T>
+	class NameIndex
+	{
+	public:
+		// The first insertion of a name wins. Returns false if the name was already present.
+		bool Insert(const HashedName& name, T* value)
+		{
+			if ((m_Count + 1) * 2 > m_Entries.size())
+			{
+				Grow();
+			}
+
+			Entry& entry = Probe(m_Entries, name);
+			if (entry.m_Value)
+			{
+				return false;
+			}
+
+			entry = { name, value };
+			++m_Count;
+
+			return true;
+		}
+
+		void InsertOrAssign(const HashedName& name, T* value)
+		{
+			if (!Insert(name, value))
+			{
+				Probe(m_Entries, name).m_Value = value;
+			}
+		}
+
+		T* Find(const HashedName& name) const
+		{
+			if (m_Entries.empty())
+			{
+				return nullptr;
+			}
+
+			const size_t mask = m_Entries.size() - 1;
+			for (size_t i = name.GetHash() & mask; m_Entries[i].m_Value; i = (i + 1) & mask)
+			{
+				if (m_Entries[i].m_Name == name)
+				{
+					return m_Entries[i].m_Value;
+				}
+			}
+
+			return nullptr;
+		}
+
+		T* Find(std::string_view name) const
+		{
+			return Find(HashedName(name));
+		}
+
+		template <typename Function>
+		void ForEach(Function&& function) const
+		{
+			for (const Entry& entry : m_Entries)
+			{
+				if (entry.m_Value)
+				{
+					function(entry.m_Name, entry.m_Value);
+				}
+			}
+		}
+
+		void Clear()
+		{
+			m_Entries.clear();
+			m_Count = 0;
+		}
+
+		size_t GetSize() const { return m_Count; }
+
+	private:
+		struct Entry
+		{
+			HashedName m_Name;
+			T* m_Value = nullptr;  // Empty slots hold nullptr.
+		};
+
+		// The slot holding name, or the empty slot it would go in. The table is never full as the load factor is kept at or under half.
+		static Entry& Probe(std::vector<Entry>& entries, const HashedName& name)
+		{
+			const size_t mask = entries.size() - 1;
+			size_t i = name.GetHash() & mask;
+
+			while (entries[i].m_Value && entries[i].m_Name != name)
+			{
+				i = (i + 1) & mask;
+			}
+
+			return entries[i];
+		}
+
+		void Grow()
+		{
+			std::vector<Entry> entries(m_Entries.empty() ? 8 : m_Entries.size() * 2);
+
+			for (const Entry& entry : m_Entries)
+			{
+				if (entry.m_Value)
+				{
+					Probe(entries, entry.m_Name) = entry;
+				}
+			}
+
+			m_Entries.swap(entries);
+		}
+
+	private:
+		std::vector<Entry> m_Entries;  // Size is zero or a power of two.
+		size_t m_Count = 0;
+	};
+}
+
+#endif
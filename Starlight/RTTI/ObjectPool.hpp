@@ -0,0 +1,158 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace RTTI
+{
+	/*
+		Fixed size slots for instances of one type, carved out of large blocks and recycled through a free list. Each reflected type with a
+		constructor has one, see TypeDescriptor::GetObjectPool(). Constructor::NewInstances fills a batch of slots with a single lock.
+
+		Slots are raw storage: Allocate does not construct and Deallocate does not destroy. Delete does both. Blocks are only released when the
+		pool is, and instances still alive at that point are not destroyed.
+	*/
+	class ObjectPool
+	{
+	public:
+		using DestroyFunction = void (*)(void*);
+
+		ObjectPool(size_t instanceSize, size_t instanceAlignment, DestroyFunction destroy, size_t instancesPerBlock = 256)
+			: m_InstanceAlignment(instanceAlignment < alignof(void*) ? alignof(void*) : instanceAlignment),
+			  m_SlotSize(RoundUp(instanceSize < sizeof(void*) ? sizeof(void*) : instanceSize, m_InstanceAlignment)),
+			  m_InstanceSize(instanceSize), m_InstancesPerBlock(instancesPerBlock > 0 ? instancesPerBlock : 1), m_Destroy(destroy) {}
+
+		~ObjectPool()
+		{
+			for (void* block : m_Blocks)
+			{
+				::operator delete(block, std::align_val_t(m_InstanceAlignment));
+			}
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		void* Allocate()
+		{
+			void* instance = nullptr;
+			Allocate(&instance, 1);
+
+			return instance;
+		}
+
+		// Fills instances with count slots.
+		void Allocate(void** instances, size_t count)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (!m_FreeList)
+				{
+					Grow();
+				}
+
+				instances[i] = m_FreeList;
+				m_FreeList = m_FreeList->m_Next;
+			}
+
+			m_LiveCount += count;
+		}
+
+		void Deallocate(void* instance)
+		{
+			Deallocate(&instance, 1);
+		}
+
+		void Deallocate(void* const* instances, size_t count)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				m_FreeList = new (instances[i]) FreeSlot{ m_FreeList };
+			}
+
+			m_LiveCount -= count;
+		}
+
+		// Destroys the instances and returns their slots.
+		void Delete(void* instance)
+		{
+			Delete(&instance, 1);
+		}
+
+		void Delete(void* const* instances, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				m_Destroy(instances[i]);
+			}
+
+			Deallocate(instances, count);
+		}
+
+		// Allocator interface, as used by Constructor::NewInstances. Requests must fit in a slot.
+		void* Allocate(size_t size, size_t alignment)
+		{
+			assert(size <= m_SlotSize && alignment <= m_InstanceAlignment);
+			return Allocate();
+		}
+
+		void Deallocate(void* instance, size_t, size_t)
+		{
+			Deallocate(instance);
+		}
+
+		size_t GetInstanceSize() const { return m_InstanceSize; }
+		size_t GetInstanceAlignment() const { return m_InstanceAlignment; }
+
+		size_t GetLiveCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			return m_LiveCount;
+		}
+
+	private:
+		struct FreeSlot
+		{
+			FreeSlot* m_Next;
+		};
+
+		static size_t RoundUp(size_t size, size_t alignment)
+		{
+			return (size + alignment - 1) / alignment * alignment;
+		}
+
+		// Called with the mutex held. Threads the new block's slots onto the free list in address order.
+		void Grow()
+		{
+			char* block = static_cast<char*>(::operator new(m_SlotSize * m_InstancesPerBlock, std::align_val_t(m_InstanceAlignment)));
+			m_Blocks.push_back(block);
+
+			for (size_t i = m_InstancesPerBlock; i-- > 0;)
+			{
+				m_FreeList = new (block + i * m_SlotSize) FreeSlot{ m_FreeList };
+			}
+		}
+
+	private:
+		const size_t m_InstanceAlignment;
+		const size_t m_SlotSize;
+		const size_t m_InstanceSize;
+		const size_t m_InstancesPerBlock;
+		const DestroyFunction m_Destroy;
+
+		mutable std::mutex m_Mutex;
+		FreeSlot* m_FreeList = nullptr;
+		std::vector<void*> m_Blocks;
+		size_t m_LiveCount = 0;
+	};
+}
+
+#endif
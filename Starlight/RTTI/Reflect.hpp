@@ -28,12 +28,17 @@ namespace RTTI
 		return Details::Resolve<Type>();
 	}
 
-	inline const TypeDescriptor* GetType(const std::string& name)
+	inline const TypeDescriptor* GetType(std::string_view name)
 	{
 		return Details::Resolve(name);
 	}
 
-	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string>::value>::type>
+	inline const TypeDescriptor* GetType(const HashedName& name)
+	{
+		return Details::Resolve(name);
+	}
+
+	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string_view>::value && !std::is_same<std::decay_t<T>, HashedName>::value>::type>
 	const TypeDescriptor* GetType(T&& object)
 	{
 		return Details::Resolve(std::forward<T>(object));
@@ -0,0 +1,246 @@
+#ifndef STATIC_REFLECTION_H
+#define STATIC_REFLECTION_H
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "TypeDescriptor.hpp"
+#include "DataMember.hpp"
+#include "Function.hpp"
+#include "Constructor.hpp"
+
+/*
+	Compile time reflection. Instead of registering a type through Reflect, specialize StaticReflection for it, before anything resolves the type:
+
+		template <>
+		struct RTTI::StaticReflection<Pokemon>
+		{
+			static constexpr HashedName Name{ "Pokemon" };
+			static inline const StaticRegistrar<Pokemon> Registrar;
+
+			static constexpr auto Constructors = std::make_tuple(StaticConstructor<>(), StaticConstructor<const std::string&>());
+			static constexpr auto DataMembers = std::make_tuple(StaticDataMember("PokemonName", &Pokemon::m_PokemonName),
+			                                                    StaticAccessor<&Pokemon::SetPokemonHealth, &Pokemon::GetPokemonHealth>("Health"));
+			static constexpr auto MemberFunctions = std::make_tuple(StaticFunction("Print", &Pokemon::Print));
+		};
+
+	Only Name is required. The tables are constant data, so nothing but the name is registered at startup, however many types are described.
+	ForEachDataMember and VisitDataMember work on the tables directly, without Any or virtual calls.
+
+	The first resolve of the type (GetType<Pokemon>(), GetType("Pokemon"), an Any holding one, a member of that type...) fills in its TypeDescriptor
+	from the tables, so the rest of RTTI sees no difference. The members it registers live in static storage rather than on the heap. Without a
+	Registrar, lookups by name find the type only once something has resolved it by type.
+*/
+
+namespace RTTI
+{
+	template <typename Class, typename Type>
+	struct StaticDataMember
+	{
+		constexpr StaticDataMember(std::string_view name, Type Class::*dataMemberPtr) : m_Name(name), m_DataMemberPtr(dataMemberPtr) {}
+
+		template <typename Object>
+		constexpr decltype(auto) Get(Object& object) const
+		{
+			return (object.*m_DataMemberPtr);
+		}
+
+		template <typename Reflected>
+		PtrDataMember<Class, Type> MakeDataMember() const
+		{
+			return PtrDataMember<Class, Type>(m_DataMemberPtr, m_Name);
+		}
+
+		HashedName m_Name;
+		Type Class::*m_DataMemberPtr;
+	};
+
+	template <auto Setter, auto Getter>
+	struct StaticAccessor
+	{
+		constexpr explicit StaticAccessor(std::string_view name) : m_Name(name) {}
+
+		template <typename Object>
+		decltype(auto) Get(Object& object) const
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Getter)>)
+			{
+				return (object.*Getter)();
+			}
+			else
+			{
+				return Getter(object);
+			}
+		}
+
+		template <typename Reflected>
+		SetGetDataMember<Setter, Getter, Reflected> MakeDataMember() const
+		{
+			return SetGetDataMember<Setter, Getter, Reflected>(m_Name);
+		}
+
+		HashedName m_Name;
+	};
+
+	namespace Details
+	{
+		template <typename Return, typename... Args>
+		FreeFunction<Return, Args...> MakeFunction(Return(*freeFun)(Args...), const HashedName& name)
+		{
+			return FreeFunction<Return, Args...>(freeFun, name);
+		}
+
+		template <typename C, typename Return, typename... Args>
+		MemberFunction<C, Return, Args...> MakeFunction(Return(C::*memFun)(Args...), const HashedName& name)
+		{
+			return MemberFunction<C, Return, Args...>(memFun, name);
+		}
+
+		template <typename C, typename Return, typename... Args>
+		ConstMemberFunction<C, Return, Args...> MakeFunction(Return(C::*memFun)(Args...) const, const HashedName& name)
+		{
+			return ConstMemberFunction<C, Return, Args...>(memFun, name);
+		}
+	}
+
+	// Free functions, member functions and const member functions.
+	template <typename FunctionPtr>
+	struct StaticFunction
+	{
+		constexpr StaticFunction(std::string_view name, FunctionPtr functionPtr) : m_Name(name), m_FunctionPtr(functionPtr) {}
+
+		template <typename Reflected>
+		auto MakeFunction() const
+		{
+			return Details::MakeFunction(m_FunctionPtr, m_Name);
+		}
+
+		HashedName m_Name;
+		FunctionPtr m_FunctionPtr;
+	};
+
+	template <typename... Args>
+	struct StaticConstructor
+	{
+		template <typename Reflected>
+		ConstructorImplementation<Reflected, Args...> MakeConstructor() const
+		{
+			return ConstructorImplementation<Reflected, Args...>();
+		}
+	};
+
+	// Registers a statically described type's name at program start, so that GetType(name) finds it before anything has resolved it by type.
+	template <typename Type>
+	struct StaticRegistrar
+	{
+		StaticRegistrar()
+		{
+			static Details::StaticTypeEntry staticType{ []() { return Details::Resolve<Type>(); } };
+
+			std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+			Details::GetStaticTypeRegistry().Update([](NameIndex<Details::StaticTypeEntry>& staticTypeRegistry) { staticTypeRegistry.InsertOrAssign(StaticReflection<Type>::Name, &staticType); });
+		}
+	};
+
+	namespace Details
+	{
+		template <typename Type, typename = void>
+		struct HasStaticDataMembers : std::false_type {};
+
+		template <typename Type>
+		struct HasStaticDataMembers<Type, std::void_t<decltype(StaticReflection<Type>::DataMembers)>> : std::true_type {};
+
+		template <typename Type, typename = void>
+		struct HasStaticMemberFunctions : std::false_type {};
+
+		template <typename Type>
+		struct HasStaticMemberFunctions<Type, std::void_t<decltype(StaticReflection<Type>::MemberFunctions)>> : std::true_type {};
+
+		template <typename Type, typename = void>
+		struct HasStaticConstructors : std::false_type {};
+
+		template <typename Type>
+		struct HasStaticConstructors<Type, std::void_t<decltype(StaticReflection<Type>::Constructors)>> : std::true_type {};
+
+		// Called once, by the first Resolve of the type.
+		template <typename Type>
+		void BuildStaticTypeDescriptor(TypeDescriptor* typeDescriptor)
+		{
+			using Description = StaticReflection<Type>;
+
+			typeDescriptor->SetName(Description::Name);  // Names in the tables point at string literals, so they needn't be interned.
+
+			if constexpr (HasStaticConstructors<Type>::value)
+			{
+				static auto constructors = std::apply([](const auto&... entries) { return std::make_tuple(entries.template MakeConstructor<Type>()...); }, Description::Constructors);
+				std::apply([typeDescriptor](auto&... constructor) { (typeDescriptor->AddConstructor(&constructor), ...); }, constructors);
+			}
+
+			if constexpr (HasStaticDataMembers<Type>::value)
+			{
+				static auto dataMembers = std::apply([](const auto&... entries) { return std::make_tuple(entries.template MakeDataMember<Type>()...); }, Description::DataMembers);
+				std::apply([typeDescriptor](auto&... dataMember) { (typeDescriptor->AddDataMember(&dataMember), ...); }, dataMembers);
+			}
+
+			if constexpr (HasStaticMemberFunctions<Type>::value)
+			{
+				static auto memberFunctions = std::apply([](const auto&... entries) { return std::make_tuple(entries.template MakeFunction<Type>()...); }, Description::MemberFunctions);
+				std::apply([typeDescriptor](auto&... memberFunction) { (typeDescriptor->AddMemberFunction(&memberFunction), ...); }, memberFunctions);
+			}
+		}
+	}
+
+	template <typename Type>
+	constexpr size_t GetStaticDataMemberCount()
+	{
+		if constexpr (Details::HasStaticDataMembers<Type>::value)
+		{
+			return std::tuple_size_v<std::remove_const_t<decltype(StaticReflection<Type>::DataMembers)>>;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	// Calls callback with each entry of the type's DataMembers table, in order.
+	template <typename Type, typename Callback>
+	constexpr void ForEachDataMember(Callback&& callback)
+	{
+		if constexpr (Details::HasStaticDataMembers<Type>::value)
+		{
+			std::apply([&callback](const auto&... entries) { (callback(entries), ...); }, StaticReflection<Type>::DataMembers);
+		}
+	}
+
+	template <typename Type>
+	constexpr bool HasStaticDataMember(const HashedName& name)
+	{
+		bool isFound = false;
+		ForEachDataMember<Type>([&isFound, &name](const auto& entry) { isFound |= entry.m_Name == name; });
+
+		return isFound;
+	}
+
+	// Calls visitor with the named member of object: a reference for plain members, the getter's result for accessors. Returns false if there is no such member.
+	template <typename Type, typename Visitor>
+	bool VisitDataMember(Type& object, const HashedName& name, Visitor&& visitor)
+	{
+		bool isFound = false;
+		ForEachDataMember<std::remove_cv_t<Type>>([&](const auto& entry)
+		{
+			if (!isFound && entry.m_Name == name)
+			{
+				isFound = true;
+				visitor(entry.Get(object));
+			}
+		});
+
+		return isFound;
+	}
+}
+
+#endif
@@ -1,9 +1,15 @@
 #ifndef TYPE_DESCRIPTOR_H
 #define TYPE_DESCRIPTOR_H
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
-#include <map>
+#include "HashedName.hpp"
+#include "ConversionCache.hpp"
+#include "Epoch.hpp"
 
 namespace RTTI
 {
@@ -18,6 +24,11 @@ namespace RTTI
 	class TypeFactory;
 
 	class TypeDescriptor;
+	class ObjectPool;
+
+	// Specialize to describe a type at compile time instead of registering it through Reflect. See StaticReflection.hpp.
+	template <typename Type>
+	struct StaticReflection {};
 
 	namespace Details
 	{
@@ -26,14 +37,28 @@ namespace RTTI
 
 		template <typename Type>
 		TypeDescriptor* Resolve(Type&&);
+
+		template <typename Type, typename = void>
+		struct IsStaticallyReflected : std::false_type {};
+
+		template <typename Type>
+		struct IsStaticallyReflected<Type, std::void_t<decltype(StaticReflection<Type>::Name)>> : std::true_type {};
+
+		template <typename Type>
+		void BuildStaticTypeDescriptor(TypeDescriptor* typeDescriptor);
 	}	
 
+	/*
+		Registration and lookups are thread safe. A type's tables are published as a whole: registering against the type copies them, changes the
+		copy and publishes it (see Epoch.hpp), so lookups never lock. Lists such as GetBases() are returned as copies of the current tables. The
+		name is kept outside the tables and set once, so references to it stay valid.
+	*/
+
 	class TypeDescriptor
 	{
 		template <typename> friend class TypeFactory;
 
-		template <typename Type> friend TypeDescriptor* Details::Resolve();
-		template <typename Type> friend TypeDescriptor* Details::Resolve(Type&&);
+		template <typename Type> friend void Details::BuildStaticTypeDescriptor(TypeDescriptor*);
 
 	public:
 		template <typename Type, typename ...Args>
@@ -42,6 +67,8 @@ namespace RTTI
 		template <typename Type, typename ...Args>
 		void AddConstructor(Type(*)(Args...));
 
+		void AddConstructor(Constructor* constructor);
+
 		template <typename B, typename T>
 		void AddBase();
 
@@ -51,6 +78,9 @@ namespace RTTI
 		template <auto Setter, auto Getter, typename Type>
 		void AddDataMember(const std::string& name);
 
+		// Registers a member owned elsewhere, such as one built from a static description.
+		void AddDataMember(DataMember* dataMember);
+
 		template <typename Return, typename... Args>
 		void AddMemberFunction(Return freeFun(Args...), const std::string& name);
 
@@ -60,10 +90,13 @@ namespace RTTI
 		template <typename C, typename Return, typename... Args>
 		void AddMemberFunction(Return(C::*memFun)(Args...) const, const std::string& name);
 
+		void AddMemberFunction(Function* memberFunction);
+
 		template <typename From, typename To>
 		void AddConversion();
 
 		const std::string& GetName() const;
+		const HashedName& GetHashedName() const;
 
 		std::vector<Constructor*> GetConstructors() const;
 
@@ -77,25 +110,63 @@ namespace RTTI
 
 		std::vector<DataMember*> GetDataMembers() const;
 
-		DataMember* GetDataMember(const std::string &name) const;
+		// Lookups include members inherited from bases, which are flattened into each type's index at registration.
+		DataMember* GetDataMember(std::string_view name) const;
+		DataMember* GetDataMember(const HashedName& name) const;
 
 		std::vector<Function*> GetMemberFunctions() const;
 
-		const Function* GetMemberFunction(const std::string& name) const;
+		const Function* GetMemberFunction(std::string_view name) const;
+		const Function* GetMemberFunction(const HashedName& name) const;
 
 		std::vector<Conversion*> GetConversions() const;
 
 		template <typename To>
 		Conversion* GetConversion() const;
 
+		// How a value of this type can be used as one of type to, worked out on the first query and cached. Same type queries find no path, so check for those first.
+		ConversionPath GetConversionPath(const TypeDescriptor* to) const;
+
+		// Slots sized for this type, created on first use. Null if no constructor can construct the type in place.
+		ObjectPool* GetObjectPool() const;
+
 	private:
-		std::string m_Name;
+		// Everything registration changes.
+		struct Tables
+		{
+			std::vector<Base*> m_Bases;
+			std::vector<Conversion*> m_Conversions;
+			std::vector<Constructor*> m_Constructors;
+			std::vector<DataMember*> m_DataMembers;
+			std::vector<Function*> m_MemberFunctions;
+
+			NameIndex<DataMember> m_DataMemberIndex;
+			NameIndex<Function> m_MemberFunctionIndex;
+			std::vector<TypeDescriptor*> m_DerivedTypes;
+			mutable Details::ConversionCache m_ConversionCache;
+		};
+
+		const Tables& GetTables() const { return m_Tables.Load(); }
+
+		// Registers the type under name. The first name given is the type's own, later ones are aliases, so that GetName() never changes.
+		void SetName(const HashedName& name);
+
+		// Applies change and re-flattens the member indices in a single copy of the tables, then re-flattens every type deriving from this one.
+		// Called with the registration mutex held.
+		template <typename Change>
+		void UpdateMembers(Change&& change);
 
-		std::vector<Base*> m_Bases;
-		std::vector<Conversion*> m_Conversions;
-		std::vector<Constructor*> m_Constructors;
-		std::vector<DataMember*> m_DataMembers;
-		std::vector<Function*> m_MemberFunctions;
+		// Re-flattens the indices of this type and every type deriving from it, after a base has changed.
+		void RebuildMemberIndices();
+
+		static void BuildMemberIndices(Tables& tables);
+
+	private:
+		Details::Published<Tables> m_Tables;
+		mutable std::atomic<ObjectPool*> m_ObjectPool = nullptr;
+
+		std::string m_Name;
+		HashedName m_HashedName;
 
 		bool m_IsPointer;
 		bool m_IsReference;
@@ -134,58 +205,98 @@ namespace RTTI
 		using RawType = typename std::remove_cv<remove_all_ref_ptr_t<T>>::type;
 
 		template <typename T>
-		static TypeDescriptor& GetTypeDescriptor()
+		TypeDescriptor& GetTypeDescriptor()
 		{
 			static TypeDescriptor typeDescriptor;  // There is a single instance of Type Descriptor per reflected type.
 
 			return typeDescriptor;
 		}
 
-		template <typename Type>
-		TypeDescriptor*& GetTypeDescriptorPtr()
+		inline Published<NameIndex<TypeDescriptor>>& GetTypeRegistry()
 		{
-			static TypeDescriptor* typeDescriptorPtr = nullptr;
+			static Published<NameIndex<TypeDescriptor>> typeRegistry;
 
-			return typeDescriptorPtr;
+			return typeRegistry;
 		}
 
-		inline std::map<std::string, TypeDescriptor*>& GetTypeRegistry()
+		// A statically described type, registered by name at program start (see StaticRegistrar). Its descriptor is built by the first resolve.
+		struct StaticTypeEntry
 		{
-			static std::map<std::string, TypeDescriptor*> typeRegistry;
+			TypeDescriptor* (*m_Resolve)() = nullptr;
+		};
 
-			return typeRegistry;
+		inline Published<NameIndex<StaticTypeEntry>>& GetStaticTypeRegistry()
+		{
+			static Published<NameIndex<StaticTypeEntry>> staticTypeRegistry;
+
+			return staticTypeRegistry;
+		}
+
+		// Builds a statically described type exactly once, however many threads resolve it first. Those that lose the race wait for the build.
+		// Resolves made by the building thread itself, i.e. for a member function taking the type, get the partly built descriptor.
+		template <typename Type>
+		void BuildStaticTypeDescriptorOnce(TypeDescriptor* typeDescriptor)
+		{
+			static std::atomic<bool> isBuilt = false;
+			static bool isBuilding = false;
+
+			if (!isBuilt.load(std::memory_order_acquire))
+			{
+				std::lock_guard<std::recursive_mutex> lock(GetRegistrationMutex());
+
+				if (!isBuilding)
+				{
+					isBuilding = true;
+					BuildStaticTypeDescriptor<Type>(typeDescriptor);
+					isBuilt.store(true, std::memory_order_release);
+				}
+			}
 		}
 
 		template <typename Type>
 		TypeDescriptor* Resolve()
 		{
-			if (!GetTypeDescriptorPtr<RawType<Type>>())
+			TypeDescriptor* typeDescriptor = &GetTypeDescriptor<RawType<Type>>();  // Created on first use. Function local statics are thread safe.
+
+			if constexpr (IsStaticallyReflected<RawType<Type>>::value)
 			{
-				GetTypeDescriptorPtr<RawType<Type>>() = &GetTypeDescriptor<RawType<Type>>();  // Create a type descriptor if not present.
+				BuildStaticTypeDescriptorOnce<RawType<Type>>(typeDescriptor);  // Types described at compile time are filled in on first use.
 			}
 
-			return GetTypeDescriptorPtr<RawType<Type>>();
+			return typeDescriptor;
 		}
 
-		inline TypeDescriptor* Resolve(const std::string &name)
+		inline TypeDescriptor* ResolveName(const HashedName& name)
 		{
-			if (auto it = GetTypeRegistry().find(name); it != GetTypeRegistry().end())
+			StaticTypeEntry* staticType = nullptr;
 			{
-				return it->second;
+				ReadGuard readGuard;
+				if (TypeDescriptor* typeDescriptor = GetTypeRegistry().Load().Find(name))
+				{
+					return typeDescriptor;
+				}
+
+				staticType = GetStaticTypeRegistry().Load().Find(name);  // Entries are static objects, so they outlive the read section.
 			}
 
-			return nullptr;
+			// A statically described type that nothing has resolved yet. Resolving it builds it and registers it under its name.
+			return staticType ? staticType->m_Resolve() : nullptr;
+		}
+
+		inline TypeDescriptor* Resolve(const HashedName& name)
+		{
+			return ResolveName(name);
+		}
+
+		inline TypeDescriptor* Resolve(std::string_view name)
+		{
+			return ResolveName(HashedName(name));
 		}
 
 		template <typename Type>
 		TypeDescriptor* Resolve(Type &&object)
 		{
-			if (!GetTypeDescriptorPtr<RawType<Type>>())
-			{
-				GetTypeDescriptorPtr<RawType<Type>>() = &GetTypeDescriptor<RawType<Type>>();   // Create a type descriptor if not present.
-			}
-
-			return GetTypeDescriptorPtr<RawType<Type>>();
+			return Resolve<Type>();
 		}
 	}  
 } 
@@ -195,6 +306,7 @@ namespace RTTI
 #include "Constructor.hpp"
 #include "Base.hpp"
 #include "Conversion.hpp"
+#include "StaticReflection.hpp"
 
 #include "TypeDescriptor.inl"
 
@@ -1,6 +1,7 @@
 #ifndef TYPE_DESCRIPTOR_INL
 #define TYPE_DESCRIPTOR_INL
 
+#include <algorithm>
 #include "TypeDescriptor.hpp"
 #include "DataMember.hpp"
 #include "Function.hpp"
@@ -13,65 +14,76 @@ namespace RTTI
 	template <typename Type, typename... Args>
 	void TypeDescriptor::AddConstructor()
 	{
-		Constructor* constructor = new ConstructorImplementation<Type, Args...>();
-
-		m_Constructors.push_back(constructor);
+		AddConstructor(new ConstructorImplementation<Type, Args...>());
 	}
 
 	template <typename Type, typename... Args>
 	void TypeDescriptor::AddConstructor(Type(*ctorFun)(Args...))
 	{
-		Constructor* constructor = new FreeFunctionConstructor<Type, Args...>(ctorFun);
+		AddConstructor(new FreeFunctionConstructor<Type, Args...>(ctorFun));
+	}
+
+	inline void TypeDescriptor::AddConstructor(Constructor* constructor)
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 
-		m_Constructors.push_back(constructor);
+		m_Tables.Update([constructor](Tables& tables) { tables.m_Constructors.push_back(constructor); });
 	}
 
 	template <typename B, typename T>
 	void TypeDescriptor::AddBase()
 	{
-		Base* base = new BaseImplementation<B, T>;
+		Base* base = new BaseImplementation<T, B>;
+		TypeDescriptor* baseType = Details::Resolve<B>();
+
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 
-		m_Bases.push_back(base);
+		baseType->m_Tables.Update([this](Tables& tables) { tables.m_DerivedTypes.push_back(this); });
+		UpdateMembers([base](Tables& tables) { tables.m_Bases.push_back(base); });
 	}
 
 	template <typename C, typename T>
 	void TypeDescriptor::AddDataMember(T C::*dataMemPtr, const std::string &name)
 	{
-		DataMember* dataMember = new PtrDataMember<C, T>(dataMemPtr, name);
-
-		m_DataMembers.push_back(dataMember);
+		AddDataMember(new PtrDataMember<C, T>(dataMemPtr, HashedName::Intern(name)));
 	}
 
 	template <auto Setter, auto Getter, typename Type>
 	void TypeDescriptor::AddDataMember(const std::string &name)
 	{
-		DataMember* dataMember = new SetGetDataMember<Setter, Getter, Type>(name);
+		AddDataMember(new SetGetDataMember<Setter, Getter, Type>(HashedName::Intern(name)));
+	}
+
+	inline void TypeDescriptor::AddDataMember(DataMember* dataMember)
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 
-		m_DataMembers.push_back(dataMember);
+		UpdateMembers([dataMember](Tables& tables) { tables.m_DataMembers.push_back(dataMember); });
 	}
 
 	template <typename Return, typename... Args>
 	void TypeDescriptor::AddMemberFunction(Return freeFun(Args...), const std::string &name)
 	{
-		Function* memberFunction = new FreeFunction<Return, Args...>(freeFun, name);
-
-		m_MemberFunctions.push_back(memberFunction);
+		AddMemberFunction(new FreeFunction<Return, Args...>(freeFun, HashedName::Intern(name)));
 	}
 
 	template <typename C, typename Return, typename... Args>
 	void TypeDescriptor::AddMemberFunction(Return(C::*memFun)(Args...), const std::string& name)
 	{
-		Function* memberFunction = new MemberFunction<C, Return, Args...>(memFun, name);
-
-		m_MemberFunctions.push_back(memberFunction);
+		AddMemberFunction(new MemberFunction<C, Return, Args...>(memFun, HashedName::Intern(name)));
 	}
 
 	template <typename C, typename Return, typename... Args>
 	void TypeDescriptor::AddMemberFunction(Return(C::*memFun)(Args...) const, const std::string &name)
 	{
-		Function* memberFunction = new ConstMemberFunction<C, Return, Args...>(memFun, name);
+		AddMemberFunction(new ConstMemberFunction<C, Return, Args...>(memFun, HashedName::Intern(name)));
+	}
+
+	inline void TypeDescriptor::AddMemberFunction(Function* memberFunction)
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 
-		m_MemberFunctions.push_back(memberFunction);
+		UpdateMembers([memberFunction](Tables& tables) { tables.m_MemberFunctions.push_back(memberFunction); });
 	}
 
 	template <typename From, typename To>
@@ -79,7 +91,9 @@ namespace RTTI
 	{
 		Conversion* conversion = new ConversionImplementation<From, To>;
 
-		m_Conversions.push_back(conversion);
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+		m_Tables.Update([conversion](Tables& tables) { tables.m_Conversions.push_back(conversion); });  // The copied tables start with an empty conversion cache.
 	}
 
 	inline std::string const &TypeDescriptor::GetName() const
@@ -87,15 +101,23 @@ namespace RTTI
 		return m_Name; 
 	}
 
+	inline const HashedName& TypeDescriptor::GetHashedName() const
+	{
+		return m_HashedName;
+	}
+
 	inline std::vector<Constructor*> TypeDescriptor::GetConstructors() const
 	{ 
-		return m_Constructors; 
+		ReadGuard readGuard;
+		return GetTables().m_Constructors; 
 	}
 
 	template <typename... Args>
 	const Constructor* TypeDescriptor::GetConstructor() const
 	{
-		for (auto* constructor : m_Constructors)
+		ReadGuard readGuard;
+
+		for (auto* constructor : GetTables().m_Constructors)
 		{
 			if (constructor->CanConstruct<Args...>(std::index_sequence_for<Args...>()))
 			{
@@ -108,15 +130,18 @@ namespace RTTI
 
 	inline std::vector<Base*> TypeDescriptor::GetBases() const
 	{ 
-		return m_Bases; 
+		ReadGuard readGuard;
+		return GetTables().m_Bases; 
 	}
 
 	template <typename B>
 	Base* TypeDescriptor::GetBase() const
 	{
-		for (auto base : m_Bases)
+		ReadGuard readGuard;
+
+		for (auto base : GetTables().m_Bases)
 		{
-			if (base->GetType() == Details::Resolve<B>)
+			if (base->GetType() == Details::Resolve<B>())
 			{
 				return base;
 			}
@@ -127,9 +152,12 @@ namespace RTTI
 
 	inline std::vector<DataMember*> TypeDescriptor::GetDataMembers() const
 	{
-		std::vector<DataMember*> dataMembers(m_DataMembers);
+		ReadGuard readGuard;
+
+		const Tables& tables = GetTables();
+		std::vector<DataMember*> dataMembers(tables.m_DataMembers);
 
-		for (auto* base : m_Bases)
+		for (auto* base : tables.m_Bases)
 		{
 			for (auto dataMember : base->GetType()->GetDataMembers())
 			{
@@ -140,72 +168,120 @@ namespace RTTI
 		return dataMembers;
 	}
 
-	inline DataMember* TypeDescriptor::GetDataMember(const std::string& name) const
+	inline DataMember* TypeDescriptor::GetDataMember(std::string_view name) const
+	{
+		ReadGuard readGuard;
+		return GetTables().m_DataMemberIndex.Find(name);
+	}
+
+	inline DataMember* TypeDescriptor::GetDataMember(const HashedName& name) const
 	{
-		for (auto* dataMember : m_DataMembers)
+		ReadGuard readGuard;
+		return GetTables().m_DataMemberIndex.Find(name);
+	}
+
+	inline std::vector<Function*> TypeDescriptor::GetMemberFunctions() const
+	{
+		ReadGuard readGuard;
+
+		const Tables& tables = GetTables();
+		std::vector<Function*> memberFunctions(tables.m_MemberFunctions);
+
+		for (auto* base : tables.m_Bases)
 		{
-			if (dataMember->GetName() == name)
+			for (auto memberFunction : base->GetType()->GetMemberFunctions())
 			{
-				return dataMember;
+				memberFunctions.push_back(memberFunction);
 			}
 		}
 
-		for (auto* base : m_Bases)
+		return memberFunctions;
+	}
+
+	inline const Function* TypeDescriptor::GetMemberFunction(std::string_view name) const
+	{
+		ReadGuard readGuard;
+		return GetTables().m_MemberFunctionIndex.Find(name);
+	}
+
+	inline const Function* TypeDescriptor::GetMemberFunction(const HashedName& name) const
+	{
+		ReadGuard readGuard;
+		return GetTables().m_MemberFunctionIndex.Find(name);
+	}
+
+	inline void TypeDescriptor::SetName(const HashedName& name)
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+		if (m_Name.empty())
 		{
-			if (auto* baseDataMember = base->GetType()->GetDataMember(name))
-			{
-				return baseDataMember;
-			}
+			m_Name = std::string(name.GetName());
+			m_HashedName = name;
 		}
 
-		return nullptr;
+		Details::GetTypeRegistry().Update([this, &name](NameIndex<TypeDescriptor>& typeRegistry) { typeRegistry.InsertOrAssign(name, this); });
 	}
 
-	inline std::vector<Function*> TypeDescriptor::GetMemberFunctions() const
+	template <typename Change>
+	void TypeDescriptor::UpdateMembers(Change&& change)
 	{
-		std::vector<Function*> memberFunctions(m_MemberFunctions);
+		m_Tables.Update([&change](Tables& tables)
+		{
+			change(tables);
+			BuildMemberIndices(tables);
+		});
 
-		for (auto* base : m_Bases)
+		// Derived types flatten this type's members into their own indices. Tables are only retired by updates, which the registration mutex
+		// holds off, so the list can be read in place.
+		for (auto* derivedType : GetTables().m_DerivedTypes)
 		{
-			for (auto memberFunction : base->GetType()->GetMemberFunctions())
-			{
-				memberFunctions.push_back(memberFunction);
-			}
+			derivedType->RebuildMemberIndices();
 		}
+	}
 
-		return memberFunctions;
+	inline void TypeDescriptor::RebuildMemberIndices()
+	{
+		UpdateMembers([](Tables&) {});
 	}
 
-	inline const Function* TypeDescriptor::GetMemberFunction(const std::string &name) const
+	inline void TypeDescriptor::BuildMemberIndices(Tables& tables)
 	{
-		for (auto* memberFunction : m_MemberFunctions)
+		tables.m_DataMemberIndex.Clear();
+		tables.m_MemberFunctionIndex.Clear();
+
+		// First insertion wins, so a type's own members shadow those of its bases, and earlier bases shadow later ones.
+		for (auto* dataMember : tables.m_DataMembers)
 		{
-			if (memberFunction->GetName() == name)
-			{
-				return memberFunction;
-			}
+			tables.m_DataMemberIndex.Insert(dataMember->GetHashedName(), dataMember);
 		}
 
-		for (auto* base : m_Bases)
+		for (auto* memberFunction : tables.m_MemberFunctions)
 		{
-			if (auto* memberFunction = base->GetType()->GetMemberFunction(name))
-			{
-				return memberFunction;
-			}
+			tables.m_MemberFunctionIndex.Insert(memberFunction->GetHashedName(), memberFunction);
 		}
 
-		return nullptr;
+		for (auto* base : tables.m_Bases)
+		{
+			const Tables& baseTables = base->GetType()->GetTables();
+
+			baseTables.m_DataMemberIndex.ForEach([&tables](const HashedName& name, DataMember* dataMember) { tables.m_DataMemberIndex.Insert(name, dataMember); });
+			baseTables.m_MemberFunctionIndex.ForEach([&tables](const HashedName& name, Function* memberFunction) { tables.m_MemberFunctionIndex.Insert(name, memberFunction); });
+		}
 	}
 
 	inline std::vector<Conversion*> TypeDescriptor::GetConversions() const
 	{ 
-		return m_Conversions; 
+		ReadGuard readGuard;
+		return GetTables().m_Conversions; 
 	}
 
 	template <typename To>
 	Conversion* TypeDescriptor::GetConversion() const
 	{
-		for (auto conversion : m_Conversions)
+		ReadGuard readGuard;
+
+		for (auto conversion : GetTables().m_Conversions)
 		{
 			if (conversion->GetToType() == Details::Resolve<To>())
 			{
@@ -215,5 +291,65 @@ namespace RTTI
 
 		return nullptr;
 	}
+
+	inline ConversionPath TypeDescriptor::GetConversionPath(const TypeDescriptor* to) const
+	{
+		ReadGuard readGuard;
+
+		const Tables& tables = GetTables();
+
+		ConversionPath path;
+		if (tables.m_ConversionCache.Find(to, path))
+		{
+			return path;
+		}
+
+		// Bases are preferred, as they avoid a copy. Failed lookups are cached too, which is what overload resolution mostly asks for.
+		auto baseIt = std::find_if(tables.m_Bases.begin(), tables.m_Bases.end(), [to](const Base* base) { return base->GetType() == to; });
+		if (baseIt != tables.m_Bases.end())
+		{
+			path.m_Base = *baseIt;
+		}
+		else
+		{
+			auto conversionIt = std::find_if(tables.m_Conversions.begin(), tables.m_Conversions.end(), [to](const Conversion* conversion) { return conversion->GetToType() == to; });
+			if (conversionIt != tables.m_Conversions.end())
+			{
+				path.m_Conversion = *conversionIt;
+			}
+		}
+
+		tables.m_ConversionCache.Insert(to, path);
+
+		return path;
+	}
+
+	inline ObjectPool* TypeDescriptor::GetObjectPool() const
+	{
+		if (ObjectPool* objectPool = m_ObjectPool.load(std::memory_order_acquire))
+		{
+			return objectPool;
+		}
+
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+		if (ObjectPool* objectPool = m_ObjectPool.load(std::memory_order_relaxed))
+		{
+			return objectPool;
+		}
+
+		const std::vector<Constructor*>& constructors = GetTables().m_Constructors;
+		auto constructorIt = std::find_if(constructors.begin(), constructors.end(), [](const Constructor* constructor) { return constructor->CanConstructInPlace(); });
+		if (constructorIt == constructors.end())
+		{
+			return nullptr;
+		}
+
+		// Like the rest of the descriptor, the pool lives as long as the program.
+		ObjectPool* objectPool = new ObjectPool((*constructorIt)->GetInstanceSize(), (*constructorIt)->GetInstanceAlignment(), (*constructorIt)->GetDestroyFunction());
+		m_ObjectPool.store(objectPool, std::memory_order_release);
+
+		return objectPool;
+	}
 } 
 #endif 
\ No newline at end of file
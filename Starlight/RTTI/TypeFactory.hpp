@@ -23,11 +23,8 @@ namespace RTTI
 			// Create a new Type Descriptor object for our newly serialized type.
 			TypeDescriptor* typeDescriptor = Details::Resolve<Type>();
 
-			// Sets its name internally.
-			typeDescriptor->m_Name = name;
-
-			// Registers the new type in our registry.
-			Details::GetTypeRegistry()[name] = typeDescriptor;
+			// Sets its name internally and registers the new type in our registry.
+			typeDescriptor->SetName(HashedName::Intern(name));
 
 			// Returns the type factory for this object.
 			return typeFactory<Type>;
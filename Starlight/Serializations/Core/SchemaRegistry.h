@@ -0,0 +1,277 @@
+#pragma once
+#include "SerializerCore.h"
+#include "../Serializers/BinaryUtilities.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+struct SchemaField
+{
+    std::string m_KeyName;
+    BinaryUtilities::BinaryValue m_Value;
+};
+
+// Rewrites a single field from one patch to the next. Return false to drop the field.
+using SchemaFieldMigration = std::function<bool(SchemaField& field)>;
+
+// Appends fields introduced by a patch. Called once per file, after every existing field has been migrated.
+using SchemaFieldAppender = std::function<void(std::vector<SchemaField>& newFields)>;
+
+struct SchemaMigrationStep
+{
+    unsigned int m_FromPatch = 0;           // Upgrades m_FromPatch to m_FromPatch + 1.
+    SchemaFieldMigration m_MigrateField;
+    SchemaFieldAppender m_AppendFields;
+};
+
+/*
+    Tracks the current patch version of each serialization target, along with the steps that upgrade older files to it.
+
+    Patch versions are backwards compatible by definition, so a file without a migration path still loads as before. Files with one are upgraded
+    record by record in a single pass, chaining every step from the file's patch up to the current one. Loading upgrades the file in memory only;
+    rewriting it on disk is a separate, explicit step (MigrateBinaryFile). Register schemas during startup, before any serializer runs.
+*/
+class SchemaRegistry
+{
+public:
+    static SchemaRegistry& GetInstance()
+    {
+        static SchemaRegistry registryInstance;
+        return registryInstance;
+    }
+
+    void RegisterSchema(Serialization_Target targetSerializable, unsigned int currentPatch)
+    {
+        m_Schemas[targetSerializable].m_CurrentPatch = currentPatch;
+    }
+
+    void AddMigration(Serialization_Target targetSerializable, unsigned int fromPatch, SchemaFieldMigration migrateField, SchemaFieldAppender appendFields = nullptr)
+    {
+        m_Schemas[targetSerializable].m_MigrationSteps.push_back({ fromPatch, std::move(migrateField), std::move(appendFields) });
+    }
+
+    // Unregistered targets stay at patch 0.
+    unsigned int GetCurrentPatch(Serialization_Target targetSerializable) const
+    {
+        auto schema = m_Schemas.find(targetSerializable);
+        return schema != m_Schemas.end() ? schema->second.m_CurrentPatch : 0;
+    }
+
+    // True if there is an unbroken chain of steps from filePatch to the current patch.
+    bool CanMigrate(Serialization_Target targetSerializable, unsigned int filePatch) const
+    {
+        return filePatch < GetCurrentPatch(targetSerializable) && !GetMigrationChain(targetSerializable, filePatch).empty();
+    }
+
+    // Upgrades a binary file held in memory, as loaded by BinarySerializer. The file on disk is left as is. Returns false (leaving migratedBuffer empty) if there is no migration path or the file is malformed.
+    bool MigrateBinaryBuffer(const std::string& fileBuffer, std::string& migratedBuffer, Serialization_Target targetSerializable, unsigned int filePatch, const std::map<Serialization_CoreField, std::string>& coreFields) const
+    {
+        migratedBuffer.clear();
+
+        const std::vector<const SchemaMigrationStep*> migrationChain = GetMigrationChain(targetSerializable, filePatch);
+        if (migrationChain.empty())
+        {
+            return false;
+        }
+
+        std::istringstream inputStream(fileBuffer, std::ios::in | std::ios::binary);
+        std::ostringstream outputStream(std::ios::out | std::ios::binary);
+        if (!MigrateRecords(inputStream, outputStream, migrationChain, GetCurrentPatch(targetSerializable), coreFields))
+        {
+            return false;
+        }
+
+        migratedBuffer = outputStream.str();
+        return true;
+    }
+
+    // Upgrades a binary file on disk, so later loads skip the in memory migration. Never called while loading; run it explicitly (i.e. from a tool) on files
+    // that aren't open elsewhere. Returns false (leaving the file as is) if there is no migration path, the file is malformed or it can't be replaced.
+    bool MigrateBinaryFile(const std::string& filePath, Serialization_Target targetSerializable, unsigned int filePatch, const std::map<Serialization_CoreField, std::string>& coreFields) const
+    {
+        const std::vector<const SchemaMigrationStep*> migrationChain = GetMigrationChain(targetSerializable, filePatch);
+        if (migrationChain.empty())
+        {
+            return false;
+        }
+
+        const std::string temporaryPath = filePath + ".migrating";
+
+        bool isMigrated = false;
+        {
+            // Large buffers keep the pass sequential on disk. MSVC's filebuf only takes them once the files are open, before any reads or writes.
+            std::unique_ptr<char[]> inputBuffer = std::make_unique<char[]>(m_StreamBufferSize);
+            std::unique_ptr<char[]> outputBuffer = std::make_unique<char[]>(m_StreamBufferSize);
+
+            std::ifstream inputStream(filePath, std::ios::in | std::ios::binary);
+            inputStream.rdbuf()->pubsetbuf(inputBuffer.get(), m_StreamBufferSize);
+
+            std::ofstream outputStream(temporaryPath, std::ios::out | std::ios::binary);
+            outputStream.rdbuf()->pubsetbuf(outputBuffer.get(), m_StreamBufferSize);
+
+            isMigrated = !inputStream.fail() && !outputStream.fail() && MigrateRecords(inputStream, outputStream, migrationChain, GetCurrentPatch(targetSerializable), coreFields);
+        }
+
+        std::error_code errorCode;
+        if (isMigrated)
+        {
+            std::filesystem::rename(temporaryPath, filePath, errorCode);
+        }
+
+        if (!isMigrated || errorCode)
+        {
+            std::filesystem::remove(temporaryPath, errorCode);
+            std::cout << "Failed to migrate " << filePath << ".\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    // Common steps.
+    static SchemaFieldMigration RenameField(const std::string& oldKeyName, const std::string& newKeyName)
+    {
+        return [oldKeyName, newKeyName](SchemaField& field)
+        {
+            if (field.m_KeyName == oldKeyName)
+            {
+                field.m_KeyName = newKeyName;
+            }
+
+            return true;
+        };
+    }
+
+    static SchemaFieldMigration RemoveField(const std::string& keyName)
+    {
+        return [keyName](SchemaField& field) { return field.m_KeyName != keyName; };
+    }
+
+    template <typename T>
+    static SchemaFieldAppender AddField(const std::string& keyName, const T& defaultValue)
+    {
+        return [keyName, defaultValue](std::vector<SchemaField>& newFields) { newFields.push_back({ keyName, BinaryUtilities::BinaryValue::From(defaultValue) }); };
+    }
+
+private:
+    SchemaRegistry() = default;
+
+    struct Schema
+    {
+        unsigned int m_CurrentPatch = 0;
+        std::vector<SchemaMigrationStep> m_MigrationSteps;
+    };
+
+    // Steps ordered from filePatch up to the current patch. Empty if any step along the way is missing.
+    std::vector<const SchemaMigrationStep*> GetMigrationChain(Serialization_Target targetSerializable, unsigned int filePatch) const
+    {
+        std::vector<const SchemaMigrationStep*> migrationChain;
+
+        auto schema = m_Schemas.find(targetSerializable);
+        if (schema == m_Schemas.end())
+        {
+            return migrationChain;
+        }
+
+        for (unsigned int patch = filePatch; patch < schema->second.m_CurrentPatch; ++patch)
+        {
+            auto step = std::find_if(schema->second.m_MigrationSteps.begin(), schema->second.m_MigrationSteps.end(), [patch](const SchemaMigrationStep& migrationStep) { return migrationStep.m_FromPatch == patch; });
+            if (step == schema->second.m_MigrationSteps.end())
+            {
+                return { };
+            }
+
+            migrationChain.push_back(&*step);
+        }
+
+        return migrationChain;
+    }
+
+    // Copies every record from inputStream to outputStream in a single pass, chaining every step of the migration. Core fields are carried over untouched apart from the patch version.
+    static bool MigrateRecords(std::istream& inputStream, std::ostream& outputStream, const std::vector<const SchemaMigrationStep*>& migrationChain, unsigned int currentPatch, const std::map<Serialization_CoreField, std::string>& coreFields)
+    {
+        char fileMagic[sizeof(BinaryUtilities::g_BinaryMagic)] = {};
+        if (!inputStream.read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, BinaryUtilities::g_BinaryMagic, sizeof(fileMagic)) != 0)
+        {
+            std::cout << "Failed to migrate a file that is not a binary Starlight file.\n";
+            return false;
+        }
+
+        outputStream.write(BinaryUtilities::g_BinaryMagic, sizeof(BinaryUtilities::g_BinaryMagic));
+
+        const std::string& patchFieldName = coreFields.at(Serialization_CoreField::Serialization_Field_VersionPatch);
+
+        SchemaField field;
+        while (BinaryUtilities::ReadRecord(inputStream, field.m_KeyName, field.m_Value))
+        {
+            if (field.m_KeyName == patchFieldName)
+            {
+                field.m_Value = BinaryUtilities::BinaryValue::From(currentPatch);
+            }
+            else if (!IsCoreField(field.m_KeyName, coreFields) && !MigrateField(migrationChain, 0, field))
+            {
+                continue;
+            }
+
+            BinaryUtilities::WriteRecord(outputStream, field.m_KeyName, field.m_Value);
+        }
+
+        // Fields added by a step still pass through the steps after it.
+        for (size_t i = 0; i < migrationChain.size(); ++i)
+        {
+            if (!migrationChain[i]->m_AppendFields)
+            {
+                continue;
+            }
+
+            std::vector<SchemaField> newFields;
+            migrationChain[i]->m_AppendFields(newFields);
+
+            for (SchemaField& newField : newFields)
+            {
+                if (MigrateField(migrationChain, i + 1, newField))
+                {
+                    BinaryUtilities::WriteRecord(outputStream, newField.m_KeyName, newField.m_Value);
+                }
+            }
+        }
+
+        outputStream.flush();
+        return inputStream.eof() && !outputStream.fail();
+    }
+
+    static bool MigrateField(const std::vector<const SchemaMigrationStep*>& migrationChain, size_t firstStep, SchemaField& field)
+    {
+        for (size_t i = firstStep; i < migrationChain.size(); ++i)
+        {
+            if (migrationChain[i]->m_MigrateField && !migrationChain[i]->m_MigrateField(field))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool IsCoreField(const std::string& keyName, const std::map<Serialization_CoreField, std::string>& coreFields)
+    {
+        for (const auto& coreField : coreFields)
+        {
+            if (coreField.second == keyName)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    std::map<Serialization_Target, Schema> m_Schemas;
+    size_t m_StreamBufferSize = 256 * 1024;
+};
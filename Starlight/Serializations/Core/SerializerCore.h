@@ -53,7 +53,15 @@ public:
     template <typename T, typename = ValidateTypes(T)>
     void Write(const std::string& keyName, T& value)
     {
-        if (_WriteInternal(keyName, value))
+        if (_WriteInternal(keyName, value) && m_IsVerbose)
+        {
+            std::cout << "Successfully Serialized: " << keyName << " (Value: " << value << ")\n";
+        }
+    }
+
+    void Write(const std::string& keyName, const std::string& value)
+    {
+        if (_WriteInternal(keyName, value) && m_IsVerbose)
         {
             std::cout << "Successfully Serialized: " << keyName << " (Value: " << value << ")\n";
         }
@@ -62,12 +70,46 @@ public:
     template <typename T, typename = ValidateTypes(T)>
     void Read(const std::string& keyName, T* value)
     {
-        if (_ReadInternal(keyName, value))
+        if (_ReadInternal(keyName, value) && m_IsVerbose)
         {
             std::cout << "Successfully Deserialized: " << keyName << "\n";
         }
     }
 
+    void Read(const std::string& keyName, std::string* value)
+    {
+        if (_ReadInternal(keyName, value) && m_IsVerbose)
+        {
+            std::cout << "Successfully Deserialized: " << keyName << "\n";
+        }
+    }
+
+    // Per field and per file success messages. Failures are always reported. Bulk tools turn this off to keep the console out of the hot path.
+    void SetVerbose(bool isVerbose) { m_IsVerbose = isVerbose; }
+
+    Serialization_Target GetSerializationTarget() const { return m_TargetSerializable; }
+    bool IsVersionVerified() const { return m_IsVersionVerified; }
+
+    static Serialization_Target StringToSerializationTarget(const std::string& targetName)
+    {
+        if (targetName == "Scene")
+        {
+            return Serialization_Target::Serialization_Target_Scene;
+        }
+
+        if (targetName == "Settings")
+        {
+            return Serialization_Target::Serialization_Target_Settings;
+        }
+
+        if (targetName == "Assets")
+        {
+            return Serialization_Target::Serialization_Target_Assets;
+        }
+
+        return Serialization_Target::Serialization_Target_Unknown;
+    }
+
 protected:
     std::string SerializationTargetToString()
     {
@@ -105,6 +147,7 @@ private:
     virtual bool _WriteInternal(const std::string& keyName, uint16_t value) = 0;
     virtual bool _WriteInternal(const std::string& keyName, uint32_t value) = 0;
     // virtual bool _WriteInternal(const std::string& keyName, uint64_t value) = 0;
+    virtual bool _WriteInternal(const std::string& keyName, const std::string& value) = 0;
 
     // =====
 
@@ -121,8 +164,10 @@ private:
     virtual bool _ReadInternal(const std::string& keyName, uint16_t* value) = 0;
     virtual bool _ReadInternal(const std::string& keyName, uint32_t* value) = 0;
     // virtual bool _ReadInternal(const std::string& keyName, uint64_t* value) = 0;
+    virtual bool _ReadInternal(const std::string& keyName, std::string* value) = 0;
 
 protected:
+    bool m_IsVerbose = true;
     bool m_IsVersionVerified = false;
     std::string m_OperatingFilePath = "";       // The file we're operating on, whether it be a file to serialize to or deserialize from.
     Serialization_Target m_TargetSerializable = Serialization_Target::Serialization_Target_Unknown;
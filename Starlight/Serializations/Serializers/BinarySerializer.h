@@ -1,5 +1,12 @@
 #pragma once
 #include "../Core/SerializerCore.h"
+#include "../Core/SchemaRegistry.h"
+#include "BinaryUtilities.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
 
 class BinarySerializer : public SerializerCore
 {
@@ -9,21 +16,22 @@ public:
 
     void BeginSerialization() override
     {
-        m_StreamFlags |= std::ios::out;
-
-        m_OutputStream.open(m_OperatingFilePath, m_StreamFlags);
+        m_OutputStream.open(m_OperatingFilePath, m_StreamFlags | std::ios::out);
         if (m_OutputStream.fail())
         {
             std::cout << "Failed to open " << m_OperatingFilePath << " for writing.\n";
             return;
         }
 
+        m_OutputStream.write(BinaryUtilities::g_BinaryMagic, sizeof(BinaryUtilities::g_BinaryMagic));
+
         // Version Control
+        m_VersionCount_Patch = SchemaRegistry::GetInstance().GetCurrentPatch(m_TargetSerializable);
         WriteBasicType(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain], m_VersionCount_Main);
         WriteBasicType(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch], m_VersionCount_Patch);
 
         // Type
-        WriteBasicType(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch], SerializationTargetToString());
+        WriteBasicType(m_CoreFields[Serialization_CoreField::Serialization_Field_Type], SerializationTargetToString());
     }
 
     void EndSerialization() override
@@ -31,17 +39,16 @@ public:
         m_OutputStream.flush();
         m_OutputStream.close();
 
-        std::cout << "Successfully serialized " << m_OperatingFilePath << "\n";
+        if (m_IsVerbose)
+        {
+            std::cout << "Successfully serialized " << m_OperatingFilePath << "\n";
+        }
     }
 
     void BeginDeserialization() override
     {
-        m_StreamFlags |= std::ios::out;
-
-        m_InputStream.open(m_OperatingFilePath, m_StreamFlags);
-        if (m_InputStream.fail())
+        if (!LoadRecords())
         {
-            std::cout << "Failed to open " << m_OperatingFilePath << " for reading.\n";
             return;
         }
 
@@ -52,51 +59,280 @@ public:
             return;
         }
 
-        if (ReadBasicTypeAs<unsigned int>(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch]) > m_VersionCount_Patch)
+        // Type. The file's own target decides which schema it follows.
+        const Serialization_Target fileTarget = StringToSerializationTarget(ReadBasicTypeAs<std::string>(m_CoreFields[Serialization_CoreField::Serialization_Field_Type]));
+        if (m_TargetSerializable == Serialization_Target::Serialization_Target_Unknown)
+        {
+            m_TargetSerializable = fileTarget;
+        }
+
+        const SchemaRegistry& schemaRegistry = SchemaRegistry::GetInstance();
+        m_VersionCount_Patch = schemaRegistry.GetCurrentPatch(fileTarget);
+
+        const unsigned int filePatch = ReadBasicTypeAs<unsigned int>(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch]);
+        if (filePatch > m_VersionCount_Patch)
         {
             std::cout << "Invalid Patch Version. The loaded file is not compatible with the current engine.\n";
             return;
         }
 
-        // Type
-        // ReadBasicTypeAs<std::string>(m_CoreFields[Serialization_CoreField::Serialization_Field_Type]);
+        // Older patches are upgraded in memory; the file itself is only rewritten through SchemaRegistry::MigrateBinaryFile. As patches are backwards
+        // compatible, a failed migration falls back to the records as they were loaded.
+        if (filePatch < m_VersionCount_Patch && schemaRegistry.CanMigrate(fileTarget, filePatch))
+        {
+            std::string migratedBuffer;
+            if (schemaRegistry.MigrateBinaryBuffer(m_InputBuffer, migratedBuffer, fileTarget, filePatch, m_CoreFields) && SwapInputBuffer(migratedBuffer))
+            {
+                if (m_IsVerbose)
+                {
+                    std::cout << "Migrated " << m_OperatingFilePath << " from patch " << filePatch << " to " << m_VersionCount_Patch << ".\n";
+                }
+            }
+            else
+            {
+                std::cout << "Failed to migrate " << m_OperatingFilePath << " from patch " << filePatch << ". Loading it unmigrated.\n";
+            }
+        }
 
         m_IsVersionVerified = true;
     }
 
     void EndDeserialization() override
     {
-        if (m_IsVersionVerified)
+        if (m_IsVersionVerified && m_IsVerbose)
         {
-            m_InputStream.clear();
-            m_InputStream.close();
             std::cout << "Successfully Deserialized File: " << m_OperatingFilePath << "\n";
         }
+
+        m_InputBuffer.clear();
+        m_InputBuffer.shrink_to_fit();
+        m_Records.clear();
+        m_RecordIndex.clear();
+    }
+
+    // Visits every non core field in file order with its stored value. Used by tools that transcode a file without knowing its fields up front.
+    template <typename Callback>
+    void ForEachField(Callback&& callback)
+    {
+        if (!m_IsVersionVerified)
+        {
+            return;
+        }
+
+        for (const BinaryRecord& record : m_Records)
+        {
+            if (IsCoreField(record.m_KeyName))
+            {
+                continue;
+            }
+
+            BinaryUtilities::BinaryValue value;
+            ReadRecordValue(record, value);
+            callback(record.m_KeyName, value);
+        }
     }
 
 private:
+    struct BinaryRecord
+    {
+        std::string m_KeyName;
+        BinaryUtilities::BinaryTypeTag m_TypeTag = BinaryUtilities::BinaryTypeTag::Unknown;
+        size_t m_ValueOffset = 0;   // Offset of the value within m_InputBuffer.
+    };
+
     template <typename T>
-    bool WriteBasicType(const std::string& keyName, T value)
+    bool WriteBasicType(const std::string& keyName, const T& value)
     {
-        m_OutputStream.write(reinterpret_cast<char*>(&value), sizeof(value));
-        return true;
+        if (keyName.size() > UINT16_MAX)
+        {
+            std::cout << "Key " << keyName.substr(0, 32) << "... exceeds the maximum binary key length.\n";
+            return false;
+        }
+
+        const BinaryUtilities::BinaryTypeTag typeTag = BinaryUtilities::GetTypeTag<T>();
+        const uint16_t keyLength = static_cast<uint16_t>(keyName.size());
+
+        m_OutputStream.write(reinterpret_cast<const char*>(&typeTag), sizeof(typeTag));
+        m_OutputStream.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+        m_OutputStream.write(keyName.data(), keyLength);
+
+        if constexpr (std::is_same<T, std::string>::value)
+        {
+            const uint32_t stringLength = static_cast<uint32_t>(value.size());
+            m_OutputStream.write(reinterpret_cast<const char*>(&stringLength), sizeof(stringLength));
+            m_OutputStream.write(value.data(), stringLength);
+        }
+        else
+        {
+            m_OutputStream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        return !m_OutputStream.fail();
     }
 
     template <typename T>
     bool ReadBasicType(const std::string& keyName, T* value)
     {
-        m_InputStream.read(reinterpret_cast<char*>(value), sizeof(T));
+        auto recordEntry = m_RecordIndex.find(keyName);
+        if (recordEntry == m_RecordIndex.end())
+        {
+            std::cout << "Failed to find " << keyName << " in " << m_OperatingFilePath << ".\n";
+            return false;
+        }
+
+        BinaryUtilities::BinaryValue storedValue;
+        ReadRecordValue(m_Records[recordEntry->second], storedValue);
+
+        if (!storedValue.As(value))
+        {
+            std::cout << "Failed to convert " << keyName << " to the requested type.\n";
+            return false;
+        }
+
         return true;
     }
 
     template <typename T>
     T ReadBasicTypeAs(const std::string& keyName)
     {
-        T value;
+        T value = T();
         ReadBasicType(keyName, &value);
         return value;
     }
 
+    bool LoadRecords()
+    {
+        m_InputBuffer.clear();
+
+        m_InputStream.open(m_OperatingFilePath, m_StreamFlags | std::ios::in);
+        if (m_InputStream.fail())
+        {
+            std::cout << "Failed to open " << m_OperatingFilePath << " for reading.\n";
+            return false;
+        }
+
+        // The whole file is read up front. Records are then indexed and read from memory rather than seeking the stream per field.
+        m_InputBuffer.assign(std::istreambuf_iterator<char>(m_InputStream), std::istreambuf_iterator<char>());
+        m_InputStream.close();
+
+        if (!IndexRecords())
+        {
+            std::cout << m_OperatingFilePath << " is not a valid binary Starlight file.\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    // Replaces the loaded file with another buffer, keeping the current one if the new one doesn't index.
+    bool SwapInputBuffer(std::string& inputBuffer)
+    {
+        m_InputBuffer.swap(inputBuffer);
+        if (IndexRecords())
+        {
+            return true;
+        }
+
+        m_InputBuffer.swap(inputBuffer);
+        IndexRecords();
+        return false;
+    }
+
+    // Walks the record headers once, skipping over values. Returns false if the file is truncated or isn't in the record layout.
+    bool IndexRecords()
+    {
+        m_Records.clear();
+        m_RecordIndex.clear();
+
+        const size_t magicSize = sizeof(BinaryUtilities::g_BinaryMagic);
+        if (m_InputBuffer.size() < magicSize || m_InputBuffer.compare(0, magicSize, BinaryUtilities::g_BinaryMagic, magicSize) != 0)
+        {
+            return false;
+        }
+
+        size_t readOffset = magicSize;
+        while (readOffset < m_InputBuffer.size())
+        {
+            BinaryRecord record;
+            uint16_t keyLength = 0;
+
+            if (!ReadFromBuffer(readOffset, &record.m_TypeTag, sizeof(record.m_TypeTag)) || !ReadFromBuffer(readOffset, &keyLength, sizeof(keyLength)) || readOffset + keyLength > m_InputBuffer.size())
+            {
+                return false;
+            }
+
+            record.m_KeyName.assign(m_InputBuffer, readOffset, keyLength);
+            readOffset += keyLength;
+            record.m_ValueOffset = readOffset;
+
+            if (record.m_TypeTag == BinaryUtilities::BinaryTypeTag::String)
+            {
+                uint32_t stringLength = 0;
+                if (!ReadFromBuffer(readOffset, &stringLength, sizeof(stringLength)))
+                {
+                    return false;
+                }
+
+                readOffset += stringLength;
+            }
+            else
+            {
+                const size_t valueSize = BinaryUtilities::GetFixedSize(record.m_TypeTag);
+                if (valueSize == 0)
+                {
+                    return false; // Unknown tag.
+                }
+
+                readOffset += valueSize;
+            }
+
+            if (readOffset > m_InputBuffer.size())
+            {
+                return false;
+            }
+
+            // Later records overwrite earlier ones of the same key, matching what a YAML map would keep.
+            m_RecordIndex[record.m_KeyName] = m_Records.size();
+            m_Records.emplace_back(std::move(record));
+        }
+
+        return true;
+    }
+
+    void ReadRecordValue(const BinaryRecord& record, BinaryUtilities::BinaryValue& value) const
+    {
+        // Bounds were checked when the records were indexed.
+        if (record.m_TypeTag == BinaryUtilities::BinaryTypeTag::String)
+        {
+            const uint32_t stringLength = BinaryUtilities::LoadUnaligned<uint32_t>(m_InputBuffer.data() + record.m_ValueOffset);
+            value.m_TypeTag = record.m_TypeTag;
+            value.m_String.assign(m_InputBuffer, record.m_ValueOffset + sizeof(uint32_t), stringLength);
+            return;
+        }
+
+        BinaryUtilities::DecodeFixedValue(record.m_TypeTag, m_InputBuffer.data() + record.m_ValueOffset, value);
+    }
+
+    bool ReadFromBuffer(size_t& readOffset, void* destination, size_t size) const
+    {
+        if (readOffset + size > m_InputBuffer.size())
+        {
+            return false;
+        }
+
+        std::memcpy(destination, m_InputBuffer.data() + readOffset, size);
+        readOffset += size;
+
+        return true;
+    }
+
+    bool IsCoreField(const std::string& keyName)
+    {
+        return keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain] ||
+               keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch] ||
+               keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_Type];
+    }
+
 private:
     bool _WriteInternal(const std::string& keyName, bool value) override
     {
@@ -153,6 +389,11 @@ private:
         return WriteBasicType(keyName, value);
     }
 
+    bool _WriteInternal(const std::string& keyName, const std::string& value) override
+    {
+        return WriteBasicType(keyName, value);
+    }
+
     bool _ReadInternal(const std::string& keyName, bool* value) override
     {
         return ReadBasicType(keyName, value);
@@ -208,9 +449,18 @@ private:
         return ReadBasicType(keyName, value);
     }
 
+    bool _ReadInternal(const std::string& keyName, std::string* value) override
+    {
+        return ReadBasicType(keyName, value);
+    }
+
 private:
-    int m_StreamFlags = std::ios::binary; // Accesses the file as a binary file - no formatting is done.
+    std::ios::openmode m_StreamFlags = std::ios::binary; // Accesses the file as a binary file - no formatting is done.
 
     std::ofstream m_OutputStream;
     std::ifstream m_InputStream;
+
+    std::string m_InputBuffer;
+    std::vector<BinaryRecord> m_Records;                        // File order.
+    std::unordered_map<std::string, size_t> m_RecordIndex;      // Key -> Index into m_Records.
 };
\ No newline at end of file
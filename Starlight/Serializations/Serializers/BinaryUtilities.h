@@ -0,0 +1,320 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+/*
+    Binary Layout:
+
+    [Magic - 4 Bytes]
+    [Record]...
+
+    Record: [Type Tag - uint8_t][Key Length - uint16_t][Key][Value]
+    Value: Fixed size per tag in native byte order. Strings are stored as [Length - uint32_t][Characters].
+
+    Every field, the version header included, is a self describing record. Files can thus be read by key and transcoded without knowing the type that wrote them.
+*/
+
+namespace BinaryUtilities
+{
+    static const char g_BinaryMagic[4] = { 'S', 'L', 'B', 'N' };
+
+    enum class BinaryTypeTag : uint8_t
+    {
+        Bool,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Int32,
+        Int64,
+        Float,
+        Double,
+        String,
+        Unknown
+    };
+
+    // Types of the same size and signedness share a tag so that the layout doesn't depend on the platform's width of long.
+    template <typename T>
+    constexpr BinaryTypeTag GetTypeTag()
+    {
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            return BinaryTypeTag::Bool;
+        }
+        else if constexpr (std::is_same<T, std::string>::value)
+        {
+            return BinaryTypeTag::String;
+        }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            return sizeof(T) == sizeof(float) ? BinaryTypeTag::Float : BinaryTypeTag::Double;
+        }
+        else if constexpr (std::is_signed<T>::value)
+        {
+            return sizeof(T) <= sizeof(int32_t) ? BinaryTypeTag::Int32 : BinaryTypeTag::Int64;
+        }
+        else
+        {
+            return sizeof(T) == 1 ? BinaryTypeTag::UInt8 : sizeof(T) == 2 ? BinaryTypeTag::UInt16 : sizeof(T) == 4 ? BinaryTypeTag::UInt32 : BinaryTypeTag::UInt64;
+        }
+    }
+
+    // Size of a record's value in bytes. Strings are variable in length and return 0.
+    inline size_t GetFixedSize(BinaryTypeTag typeTag)
+    {
+        switch (typeTag)
+        {
+        case BinaryTypeTag::Bool:
+        case BinaryTypeTag::UInt8:
+            return 1;
+
+        case BinaryTypeTag::UInt16:
+            return 2;
+
+        case BinaryTypeTag::UInt32:
+        case BinaryTypeTag::Int32:
+        case BinaryTypeTag::Float:
+            return 4;
+
+        case BinaryTypeTag::UInt64:
+        case BinaryTypeTag::Int64:
+        case BinaryTypeTag::Double:
+            return 8;
+
+        default:
+            return 0;
+        }
+    }
+
+    // A single record's value, widened to the largest type of its kind.
+    struct BinaryValue
+    {
+        BinaryTypeTag m_TypeTag = BinaryTypeTag::Unknown;
+        union
+        {
+            bool m_Bool;
+            uint64_t m_Unsigned;
+            int64_t m_Signed;
+            double m_Floating;
+        };
+        std::string m_String;
+
+        BinaryValue() : m_Unsigned(0) { }
+
+        template <typename T>
+        static BinaryValue From(const T& value)
+        {
+            BinaryValue binaryValue;
+            binaryValue.m_TypeTag = GetTypeTag<T>();
+
+            if constexpr (std::is_same<T, std::string>::value)
+            {
+                binaryValue.m_String = value;
+            }
+            else if constexpr (std::is_same<T, bool>::value)
+            {
+                binaryValue.m_Bool = value;
+            }
+            else if constexpr (std::is_floating_point<T>::value)
+            {
+                binaryValue.m_Floating = static_cast<double>(value);
+            }
+            else if constexpr (std::is_signed<T>::value)
+            {
+                binaryValue.m_Signed = static_cast<int64_t>(value);
+            }
+            else
+            {
+                binaryValue.m_Unsigned = static_cast<uint64_t>(value);
+            }
+
+            return binaryValue;
+        }
+
+        bool IsUnsigned() const { return m_TypeTag == BinaryTypeTag::UInt8 || m_TypeTag == BinaryTypeTag::UInt16 || m_TypeTag == BinaryTypeTag::UInt32 || m_TypeTag == BinaryTypeTag::UInt64; }
+        bool IsSigned() const { return m_TypeTag == BinaryTypeTag::Int32 || m_TypeTag == BinaryTypeTag::Int64; }
+        bool IsFloating() const { return m_TypeTag == BinaryTypeTag::Float || m_TypeTag == BinaryTypeTag::Double; }
+
+        // Numbers convert between each other (i.e. a field written as int can be read as a float). Strings only convert to strings.
+        template <typename T>
+        bool As(T* value) const
+        {
+            if constexpr (std::is_same<T, std::string>::value)
+            {
+                if (m_TypeTag != BinaryTypeTag::String)
+                {
+                    return false;
+                }
+
+                *value = m_String;
+            }
+            else
+            {
+                if (m_TypeTag == BinaryTypeTag::Bool)
+                {
+                    *value = static_cast<T>(m_Bool);
+                }
+                else if (IsUnsigned())
+                {
+                    *value = static_cast<T>(m_Unsigned);
+                }
+                else if (IsSigned())
+                {
+                    *value = static_cast<T>(m_Signed);
+                }
+                else if (IsFloating())
+                {
+                    *value = static_cast<T>(m_Floating);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    template <typename T>
+    T LoadUnaligned(const char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void StoreUnaligned(char* data, T value)
+    {
+        std::memcpy(data, &value, sizeof(T));
+    }
+
+    // Widens a fixed size value stored at the tag's width. data must hold GetFixedSize(typeTag) bytes.
+    inline void DecodeFixedValue(BinaryTypeTag typeTag, const char* data, BinaryValue& value)
+    {
+        value.m_TypeTag = typeTag;
+
+        switch (typeTag)
+        {
+        case BinaryTypeTag::Bool:   value.m_Bool = data[0] != 0;                            break;
+        case BinaryTypeTag::UInt8:  value.m_Unsigned = LoadUnaligned<uint8_t>(data);        break;
+        case BinaryTypeTag::UInt16: value.m_Unsigned = LoadUnaligned<uint16_t>(data);       break;
+        case BinaryTypeTag::UInt32: value.m_Unsigned = LoadUnaligned<uint32_t>(data);       break;
+        case BinaryTypeTag::UInt64: value.m_Unsigned = LoadUnaligned<uint64_t>(data);       break;
+        case BinaryTypeTag::Int32:  value.m_Signed = LoadUnaligned<int32_t>(data);          break;
+        case BinaryTypeTag::Int64:  value.m_Signed = LoadUnaligned<int64_t>(data);          break;
+        case BinaryTypeTag::Float:  value.m_Floating = LoadUnaligned<float>(data);          break;
+        case BinaryTypeTag::Double: value.m_Floating = LoadUnaligned<double>(data);         break;
+        default:                                                                            break;
+        }
+    }
+
+    // Narrows a fixed size value back to its tag's width. data must hold GetFixedSize(value.m_TypeTag) bytes.
+    inline void EncodeFixedValue(const BinaryValue& value, char* data)
+    {
+        switch (value.m_TypeTag)
+        {
+        case BinaryTypeTag::Bool:   data[0] = value.m_Bool ? 1 : 0;                                             break;
+        case BinaryTypeTag::UInt8:  StoreUnaligned(data, static_cast<uint8_t>(value.m_Unsigned));               break;
+        case BinaryTypeTag::UInt16: StoreUnaligned(data, static_cast<uint16_t>(value.m_Unsigned));              break;
+        case BinaryTypeTag::UInt32: StoreUnaligned(data, static_cast<uint32_t>(value.m_Unsigned));              break;
+        case BinaryTypeTag::UInt64: StoreUnaligned(data, static_cast<uint64_t>(value.m_Unsigned));              break;
+        case BinaryTypeTag::Int32:  StoreUnaligned(data, static_cast<int32_t>(value.m_Signed));                 break;
+        case BinaryTypeTag::Int64:  StoreUnaligned(data, static_cast<int64_t>(value.m_Signed));                 break;
+        case BinaryTypeTag::Float:  StoreUnaligned(data, static_cast<float>(value.m_Floating));                 break;
+        case BinaryTypeTag::Double: StoreUnaligned(data, static_cast<double>(value.m_Floating));                break;
+        default:                                                                                                break;
+        }
+    }
+
+    // Streams a single record. Used by passes that rewrite a file record by record without loading it whole.
+    inline bool WriteRecord(std::ostream& outputStream, const std::string& keyName, const BinaryValue& value)
+    {
+        const size_t valueSize = GetFixedSize(value.m_TypeTag);
+        if (keyName.size() > UINT16_MAX || (valueSize == 0 && value.m_TypeTag != BinaryTypeTag::String))
+        {
+            return false;
+        }
+
+        const uint16_t keyLength = static_cast<uint16_t>(keyName.size());
+        outputStream.write(reinterpret_cast<const char*>(&value.m_TypeTag), sizeof(value.m_TypeTag));
+        outputStream.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+        outputStream.write(keyName.data(), keyLength);
+
+        if (value.m_TypeTag == BinaryTypeTag::String)
+        {
+            const uint32_t stringLength = static_cast<uint32_t>(value.m_String.size());
+            outputStream.write(reinterpret_cast<const char*>(&stringLength), sizeof(stringLength));
+            outputStream.write(value.m_String.data(), stringLength);
+        }
+        else
+        {
+            char valueData[8];
+            EncodeFixedValue(value, valueData);
+            outputStream.write(valueData, valueSize);
+        }
+
+        return !outputStream.fail();
+    }
+
+    // Returns false at the end of the stream or on a truncated or malformed record. Check the stream's eof() to tell them apart.
+    inline bool ReadRecord(std::istream& inputStream, std::string& keyName, BinaryValue& value)
+    {
+        BinaryTypeTag typeTag = BinaryTypeTag::Unknown;
+        uint16_t keyLength = 0;
+
+        if (!inputStream.read(reinterpret_cast<char*>(&typeTag), sizeof(typeTag)))
+        {
+            return false;
+        }
+
+        if (!inputStream.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength)))
+        {
+            inputStream.clear(std::ios::failbit); // Truncated, not a clean end of stream.
+            return false;
+        }
+
+        keyName.resize(keyLength);
+        if (keyLength > 0 && !inputStream.read(&keyName[0], keyLength))
+        {
+            inputStream.clear(std::ios::failbit);
+            return false;
+        }
+
+        if (typeTag == BinaryTypeTag::String)
+        {
+            uint32_t stringLength = 0;
+            if (!inputStream.read(reinterpret_cast<char*>(&stringLength), sizeof(stringLength)))
+            {
+                inputStream.clear(std::ios::failbit);
+                return false;
+            }
+
+            value.m_TypeTag = typeTag;
+            value.m_String.resize(stringLength);
+            if (stringLength > 0 && !inputStream.read(&value.m_String[0], stringLength))
+            {
+                inputStream.clear(std::ios::failbit);
+                return false;
+            }
+
+            return true;
+        }
+
+        const size_t valueSize = GetFixedSize(typeTag);
+        char valueData[8];
+        if (valueSize == 0 || !inputStream.read(valueData, valueSize))
+        {
+            inputStream.clear(std::ios::failbit);
+            return false;
+        }
+
+        DecodeFixedValue(typeTag, valueData, value);
+        return true;
+    }
+}
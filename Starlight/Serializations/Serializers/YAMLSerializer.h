@@ -1,7 +1,11 @@
 #pragma once
 #include "../Core/SerializerCore.h"
+#include "../Core/SchemaRegistry.h"
+#include "YAMLUtilities.h"
 #include <yaml-cpp/yaml.h>
 #include <fstream>
+#include <memory>
+#include <unordered_map>
 
 class YAMLSerializer : public SerializerCore
 {
@@ -9,41 +13,100 @@ public:
     YAMLSerializer() = delete;
     YAMLSerializer(Serialization_Target targetSerializable, const std::string& filePath) : SerializerCore(targetSerializable, filePath) { }
 
+    // Streams emitter output to disk through a fixed size buffer as it is produced, instead of building the whole document in memory first. Must be called before BeginSerialization().
+    void EnableStreaming(size_t bufferSize = 64 * 1024)
+    {
+        m_StreamBufferSize = bufferSize > 0 ? bufferSize : 1;
+    }
+
     void BeginSerialization() override
     {
-        m_StreamEmitter << YAML::BeginMap;
+        if (m_StreamBufferSize > 0)
+        {
+            m_OutputStream.open(m_OperatingFilePath);
+            if (m_OutputStream.fail())
+            {
+                std::cout << "Failed to open " << m_OperatingFilePath << " for writing.\n";
+            }
+
+            // MSVC's filebuf only takes a buffer once its file is open, and before anything has been written.
+            m_StreamBuffer = std::make_unique<char[]>(m_StreamBufferSize);
+            m_OutputStream.rdbuf()->pubsetbuf(m_StreamBuffer.get(), m_StreamBufferSize);
+
+            m_StreamEmitter = std::make_unique<YAML::Emitter>(m_OutputStream);
+        }
+        else
+        {
+            m_StreamEmitter = std::make_unique<YAML::Emitter>();
+        }
+
+        *m_StreamEmitter << YAML::BeginMap;
         
         // Version Control
-        m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain] << YAML::Value << m_VersionCount_Main;
-        m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch] << YAML::Value << m_VersionCount_Patch;
+        m_VersionCount_Patch = SchemaRegistry::GetInstance().GetCurrentPatch(m_TargetSerializable);
+        *m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain] << YAML::Value << m_VersionCount_Main;
+        *m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch] << YAML::Value << m_VersionCount_Patch;
 
         // Type
-        m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_Type] << YAML::Value << SerializationTargetToString();
+        *m_StreamEmitter << YAML::Key << m_CoreFields[Serialization_CoreField::Serialization_Field_Type] << YAML::Value << SerializationTargetToString();
     }
 
     void EndSerialization() override
     {
-        m_StreamEmitter << YAML::EndMap;
-        m_StreamEmitter << "This file is created for usage with Starlight. All rights reserved. GitHub Link : https://github.com/xRiveria/Starlight";
+        *m_StreamEmitter << YAML::EndMap;
+        *m_StreamEmitter << "This file is created for usage with Starlight. All rights reserved. GitHub Link : https://github.com/xRiveria/Starlight";
 
-        std::ofstream outputFile(m_OperatingFilePath);
-        outputFile << m_StreamEmitter.c_str();
+        if (m_StreamBufferSize > 0)
+        {
+            // Everything but the tail of the document has already been written out.
+            m_OutputStream.flush();
+            m_OutputStream.close();
+        }
+        else
+        {
+            std::ofstream outputFile(m_OperatingFilePath);
+            outputFile << m_StreamEmitter->c_str();
+        }
 
-        std::cout << "Serialization Complete. Outputted to: " << m_OperatingFilePath << "\n";
+        m_StreamEmitter.reset();
+
+        if (m_IsVerbose)
+        {
+            std::cout << "Serialization Complete. Outputted to: " << m_OperatingFilePath << "\n";
+        }
+    }
+
+    // Indexes the top level keys of the file in a single scan and only parses a key's subtree once it is read. Must be called before BeginDeserialization().
+    void EnableLazyLoading()
+    {
+        m_IsLazyLoading = true;
     }
 
     void BeginDeserialization() override
     {
-        m_StreamNode = YAML::LoadFile(m_OperatingFilePath);
+        if (!m_IsLazyLoading || !BuildLazyIndex())
+        {
+            LoadWholeFile();
+        }
 
         // Ensure that our version matches the serialized file.
-        if (m_StreamNode[m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain]].as<unsigned int>() != m_VersionCount_Main) // Loaded main versions must be equal.
+        if (GetNode(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain]).as<unsigned int>() != m_VersionCount_Main) // Loaded main versions must be equal.
         {
             std::cout << "Invalid Main Version. The loaded file is not compatible with the current engine.\n";
             return;
         }
 
-        if (m_StreamNode[m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch]].as<unsigned int>() > m_VersionCount_Patch) // Loaded patch versions must be less than or equal to the current version.
+        // Type. The file's own target decides which schema it follows.
+        const YAML::Node typeNode = GetNode(m_CoreFields[Serialization_CoreField::Serialization_Field_Type]);
+        const Serialization_Target fileTarget = typeNode.IsScalar() ? StringToSerializationTarget(typeNode.Scalar()) : Serialization_Target::Serialization_Target_Unknown;
+        if (m_TargetSerializable == Serialization_Target::Serialization_Target_Unknown)
+        {
+            m_TargetSerializable = fileTarget;
+        }
+
+        // Older patches load as is. Schema migrations rewrite binary files only.
+        m_VersionCount_Patch = SchemaRegistry::GetInstance().GetCurrentPatch(fileTarget);
+        if (GetNode(m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch]).as<unsigned int>() > m_VersionCount_Patch) // Loaded patch versions must be less than or equal to the current version.
         {
             std::cout << "Invalid Patch Version. The loaded file is not compatible with the current engine.\n";
             return;
@@ -54,17 +117,70 @@ public:
 
     void EndDeserialization() override
     {
-        if (m_IsVersionVerified)
+        if (m_IsVersionVerified && m_IsVerbose)
         {
             std::cout << "Successfully Deserialized File: " << m_OperatingFilePath << "\n";
         }
+
+        m_InputStream.close();
+        m_LazyIndex.clear();
+        m_NodeCache.clear();
+    }
+
+    // Visits every non core top level field in file order. Used by tools that transcode a file without knowing its fields up front. Lazily loaded files are loaded in full first.
+    template <typename Callback>
+    void ForEachField(Callback&& callback)
+    {
+        if (!m_IsVersionVerified)
+        {
+            return;
+        }
+
+        if (m_IsLazyLoading)
+        {
+            LoadWholeFile();
+        }
+
+        for (const auto& entry : m_StreamNode)
+        {
+            const std::string& keyName = entry.first.Scalar();
+            if (keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_VersionMain] ||
+                keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_VersionPatch] ||
+                keyName == m_CoreFields[Serialization_CoreField::Serialization_Field_Type])
+            {
+                continue;
+            }
+
+            callback(keyName, entry.second);
+        }
     }
 
 private:
     template <typename T>
     bool WriteBasicType(const std::string& keyName, T value)
     {
-        m_StreamEmitter << YAML::Key << keyName << YAML::Value << value;
+        if constexpr (std::is_same<T, std::string>::value)
+        {
+            // Strings that would read back as another type (i.e. "500" or "true") are quoted to keep them strings.
+            if (YAMLUtilities::GetScalarKind(YAML::Node(value)) != YAMLUtilities::ScalarKind::String)
+            {
+                *m_StreamEmitter << YAML::Key << keyName << YAML::Value << YAML::DoubleQuoted << value;
+                return true;
+            }
+        }
+        else if constexpr (YAMLUtilities::IsFastNumber<T>)
+        {
+            // yaml-cpp's own number formatting builds a std::stringstream with max_digits10 precision per value, which dominates large writes.
+            YAMLUtilities::FormattedNumber number;
+            if (YAMLUtilities::FormatNumber(value, number))
+            {
+                *m_StreamEmitter << YAML::Key << keyName << YAML::Value;
+                m_StreamEmitter->WriteIntegralType(number);
+                return true;
+            }
+        }
+
+        *m_StreamEmitter << YAML::Key << keyName << YAML::Value << value;
 
         return true;
     }
@@ -74,13 +190,175 @@ private:
     {
         if (m_IsVersionVerified)
         {
-            *value = m_StreamNode[keyName].as<T>();
+            const YAML::Node node = GetNode(keyName);
+
+            if constexpr (YAMLUtilities::IsFastNumber<T>)
+            {
+                if (node.IsScalar() && YAMLUtilities::ParseNumber(node.Scalar(), value))
+                {
+                    return true;
+                }
+            }
+
+            *value = node.as<T>();
             return true;
         }
 
         return false;
     }
 
+    YAML::Node GetNode(const std::string& keyName)
+    {
+        if (auto cachedNode = m_NodeCache.find(keyName); cachedNode != m_NodeCache.end())
+        {
+            return cachedNode->second;
+        }
+
+        if (!m_IsLazyLoading)
+        {
+            return m_StreamNode[keyName];
+        }
+
+        auto indexEntry = m_LazyIndex.find(keyName);
+        if (indexEntry == m_LazyIndex.end())
+        {
+            return YAML::Node();
+        }
+
+        // Only the lines belonging to this key are read and parsed.
+        std::string subtreeText(static_cast<size_t>(indexEntry->second.second - indexEntry->second.first), '\0');
+        m_InputStream.clear();
+        m_InputStream.seekg(indexEntry->second.first);
+        m_InputStream.read(&subtreeText[0], subtreeText.size());
+
+        try
+        {
+            YAML::Node subtreeNode = YAML::Load(subtreeText)[keyName];
+            m_NodeCache[keyName] = subtreeNode;
+
+            return subtreeNode;
+        }
+        catch (const YAML::Exception&)
+        {
+            // The subtree can't stand on its own (i.e. an alias to an anchor defined under another key). Fall back to loading the whole file.
+            LoadWholeFile();
+
+            return GetNode(keyName);
+        }
+    }
+
+    void LoadWholeFile()
+    {
+        m_IsLazyLoading = false;
+        m_StreamNode = YAML::LoadFile(m_OperatingFilePath);
+
+        // yaml-cpp looks map keys up with a linear scan, so index the top level once to keep reads O(1).
+        m_NodeCache.clear();
+        if (m_StreamNode.IsMap())
+        {
+            m_NodeCache.reserve(m_StreamNode.size());
+            for (const auto& entry : m_StreamNode)
+            {
+                m_NodeCache.emplace(entry.first.Scalar(), entry.second);
+            }
+        }
+    }
+
+    // Records the byte range of every top level key in the first document. Returns false if the file uses a layout we can't index, in which case the whole file is loaded instead.
+    bool BuildLazyIndex()
+    {
+        m_InputStream.open(m_OperatingFilePath, std::ios::binary);
+        if (m_InputStream.fail())
+        {
+            std::cout << "Failed to open " << m_OperatingFilePath << " for reading.\n";
+            return false;
+        }
+
+        std::string line;
+        std::string previousKey;
+        std::streamoff lineOffset = 0;
+
+        while (std::getline(m_InputStream, line))
+        {
+            const std::streamoff nextLineOffset = lineOffset + static_cast<std::streamoff>(line.size()) + 1;
+
+            // Nested content, blank lines and comments belong to the key above them.
+            if (line.empty() || line[0] == ' ' || line[0] == '\t' || line[0] == '\r' || line[0] == '#')
+            {
+                lineOffset = nextLineOffset;
+                continue;
+            }
+
+            // End of the first document.
+            if (line.compare(0, 3, "---") == 0 || line.compare(0, 3, "...") == 0)
+            {
+                break;
+            }
+
+            // Top level sequences, flow collections, complex keys and directives are left to the full parser.
+            std::string keyName;
+            if (line[0] == '-' || line[0] == '{' || line[0] == '[' || line[0] == '?' || line[0] == '%' || line[0] == '&' || line[0] == '*' || line[0] == '!' || !ParseTopLevelKey(line, keyName))
+            {
+                m_InputStream.close();
+                m_LazyIndex.clear();
+                return false;
+            }
+
+            if (!previousKey.empty())
+            {
+                m_LazyIndex[previousKey].second = lineOffset;
+            }
+
+            m_LazyIndex[keyName] = { lineOffset, lineOffset };
+            previousKey = keyName;
+            lineOffset = nextLineOffset;
+        }
+
+        if (!previousKey.empty())
+        {
+            m_LazyIndex[previousKey].second = lineOffset;
+        }
+
+        m_InputStream.clear();
+        return true;
+    }
+
+    static bool ParseTopLevelKey(const std::string& line, std::string& keyName)
+    {
+        size_t separatorIndex = std::string::npos;
+
+        if (line[0] == '"' || line[0] == '\'')
+        {
+            const size_t closingQuote = line.find(line[0], 1);
+            if (closingQuote == std::string::npos || line.find('\\') < closingQuote)
+            {
+                return false; // Escaped keys aren't worth decoding by hand.
+            }
+
+            keyName = line.substr(1, closingQuote - 1);
+            separatorIndex = line.find(':', closingQuote);
+        }
+        else
+        {
+            // A plain key ends at the first ": " or at a ':' that ends the line.
+            for (size_t i = line.find(':'); i != std::string::npos; i = line.find(':', i + 1))
+            {
+                if (i + 1 == line.size() || line[i + 1] == ' ' || line[i + 1] == '\t' || line[i + 1] == '\r')
+                {
+                    separatorIndex = i;
+                    break;
+                }
+            }
+
+            if (separatorIndex != std::string::npos)
+            {
+                keyName = line.substr(0, line.find_last_not_of(" \t", separatorIndex - 1) + 1);
+            }
+        }
+
+        return separatorIndex != std::string::npos && !keyName.empty();
+    }
+
 private:
     bool _WriteInternal(const std::string& keyName, bool value) override
     {
@@ -137,6 +415,11 @@ private:
         return WriteBasicType(keyName, value);
     }
 
+    bool _WriteInternal(const std::string& keyName, const std::string& value) override
+    {
+        return WriteBasicType(keyName, value);
+    }
+
     bool _ReadInternal(const std::string& keyName, bool* value) override
     {
         return ReadBasicType(keyName, value);
@@ -192,7 +475,23 @@ private:
         return ReadBasicType(keyName, value);
     }
 
+    bool _ReadInternal(const std::string& keyName, std::string* value) override
+    {
+        return ReadBasicType(keyName, value);
+    }
+
 private:
-    YAML::Emitter m_StreamEmitter;
+    std::unique_ptr<YAML::Emitter> m_StreamEmitter;
     YAML::Node m_StreamNode;
+    std::unordered_map<std::string, YAML::Node> m_NodeCache;                                    // Top level key -> subtree, filled up front or as lazily loaded keys are parsed.
+
+    // Streaming
+    size_t m_StreamBufferSize = 0;              // 0 keeps the whole document in memory until EndSerialization().
+    std::unique_ptr<char[]> m_StreamBuffer;
+    std::ofstream m_OutputStream;
+
+    // Lazy Loading
+    bool m_IsLazyLoading = false;
+    std::ifstream m_InputStream;
+    std::unordered_map<std::string, std::pair<std::streamoff, std::streamoff>> m_LazyIndex;     // Key -> [Begin, End) byte range in the file.
 };
\ No newline at end of file
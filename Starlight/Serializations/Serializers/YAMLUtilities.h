@@ -1,5 +1,10 @@
 #pragma once
 #include <yaml-cpp/yaml.h>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
 
 namespace Math
 {
@@ -50,4 +55,120 @@ namespace YAML
 
         return output;
     }
-}
\ No newline at end of file
+}
+
+namespace YAMLUtilities
+{
+    // Numbers that bypass yaml-cpp's per-value std::stringstream when read. Bools and 8-bit types keep yaml-cpp's own conversion.
+    template <typename T>
+    constexpr bool IsFastNumber = (std::is_floating_point<T>::value && !std::is_same<T, long double>::value) || (std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) > 1);
+
+    // Parses the whole scalar with std::from_chars. Returns false if the text isn't in plain decimal form (i.e. hex, a leading +, .inf), in which case yaml-cpp's conversion should be used.
+    template <typename T>
+    bool ParseNumber(const std::string& text, T* value)
+    {
+        const char* textEnd = text.data() + text.size();
+        const auto result = std::from_chars(text.data(), textEnd, *value);
+
+        return result.ec == std::errc() && result.ptr == textEnd;
+    }
+
+    // A number already formatted with std::to_chars. Handed to Emitter::WriteIntegralType, it is written out as is, skipping both the emitter's
+    // max_digits10 float formatting and the plain scalar checks a std::string would go through. Floats get the shortest text that round-trips.
+    struct FormattedNumber
+    {
+        char m_Text[32];
+        size_t m_Length = 0;
+    };
+
+    inline std::ostream& operator << (std::ostream& output, const FormattedNumber& number)
+    {
+        return output.write(number.m_Text, static_cast<std::streamsize>(number.m_Length));
+    }
+
+    // Returns false for values with no plain decimal form (.inf, .nan), which are left to the emitter.
+    template <typename T>
+    bool FormatNumber(T value, FormattedNumber& number)
+    {
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            if (!std::isfinite(value))
+            {
+                return false;
+            }
+        }
+
+        const auto result = std::to_chars(number.m_Text, number.m_Text + sizeof(number.m_Text), value);
+        number.m_Length = result.ec == std::errc() ? static_cast<size_t>(result.ptr - number.m_Text) : 0;
+        return number.m_Length > 0;
+    }
+
+    enum class ScalarKind
+    {
+        Null,
+        Bool,
+        Integer,
+        UnsignedInteger,
+        Floating,
+        String
+    };
+
+    // Classifies a scalar the way a reader of the file would see it. Quoted scalars are always strings.
+    inline ScalarKind GetScalarKind(const YAML::Node& node)
+    {
+        if (node.IsNull())
+        {
+            return ScalarKind::Null;
+        }
+
+        if (!node.IsScalar() || node.Tag() == "!")
+        {
+            return ScalarKind::String;
+        }
+
+        const std::string& text = node.Scalar();
+        if (text.empty() || text == "~" || text == "null" || text == "Null" || text == "NULL")
+        {
+            return ScalarKind::Null;
+        }
+
+        // Plain decimal numbers skip yaml-cpp's stringstream based conversions. The digit check keeps from_chars from accepting "inf" and "nan".
+        const bool isDecimal = std::isdigit(static_cast<unsigned char>(text[0])) || (text.size() > 1 && (text[0] == '-' || text[0] == '.') && (std::isdigit(static_cast<unsigned char>(text[1])) || text[1] == '.'));
+        long long signedValue = 0;
+        unsigned long long unsignedValue = 0;
+        double floatingValue = 0.0;
+        bool boolValue = false;
+
+        if (isDecimal && ParseNumber(text, &signedValue))
+        {
+            return ScalarKind::Integer;
+        }
+
+        if (isDecimal && ParseNumber(text, &unsignedValue))
+        {
+            return ScalarKind::UnsignedInteger;
+        }
+
+        if (isDecimal && ParseNumber(text, &floatingValue))
+        {
+            return ScalarKind::Floating;
+        }
+
+        if (YAML::convert<bool>::decode(node, boolValue))
+        {
+            return ScalarKind::Bool;
+        }
+
+        if (YAML::convert<long long>::decode(node, signedValue))
+        {
+            return ScalarKind::Integer;
+        }
+
+        if (YAML::convert<double>::decode(node, floatingValue))
+        {
+            return ScalarKind::Floating;
+        }
+
+        return ScalarKind::String;
+    }
+}
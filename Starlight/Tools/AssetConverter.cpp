@@ -0,0 +1,462 @@
+#include "AssetConverter.h"
+#include "../IO/EngineIO.h"
+#include "../IO/FileSystem.h"
+#include "../IO/StringUtilities.h"
+#include "../Serializations/Serializers/YAMLSerializer.h"
+#include "../Serializations/Serializers/BinarySerializer.h"
+#include "../Utilities/MPMCQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace Tools
+{
+    namespace
+    {
+        std::mutex g_ConsoleMutex; // Workers report per file. Keeps their lines from interleaving.
+
+        // False if either path doesn't exist.
+        bool IsSamePath(const std::string& firstPath, const std::string& secondPath)
+        {
+            std::error_code errorCode;
+            return std::filesystem::equivalent(firstPath, secondPath, errorCode);
+        }
+
+        double ToMegabytesPerSecond(size_t bytes, double seconds)
+        {
+            return seconds > 0.0 ? (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds : 0.0;
+        }
+
+        template <typename T>
+        T ScalarAs(const YAML::Node& node)
+        {
+            T value = T();
+            if (!YAMLUtilities::ParseNumber(node.Scalar(), &value))
+            {
+                value = node.as<T>();
+            }
+
+            return value;
+        }
+
+        void PrintResult(const AssetConversionResult& result, AssetFormat targetFormat)
+        {
+            std::lock_guard<std::mutex> lock(g_ConsoleMutex);
+
+            const std::string fileName = std::filesystem::path(result.m_InputPath).filename().string();
+            if (result.m_IsSkipped)
+            {
+                std::cout << "[Converter] Skipped " << fileName << " (Already " << AssetConverter::AssetFormatToString(targetFormat) << ")\n";
+                return;
+            }
+
+            if (!result.m_IsSuccessful)
+            {
+                std::cout << "[Converter] Failed " << fileName << "\n";
+                return;
+            }
+
+            std::printf("[Converter] %s -> %s | %zu Fields | %.1f KB -> %.1f KB | %.2f ms | %.1f MB/s\n", fileName.c_str(), AssetConverter::AssetFormatToString(targetFormat), result.m_FieldCount,
+                        result.m_InputBytes / 1024.0, result.m_OutputBytes / 1024.0, result.m_Seconds * 1000.0, ToMegabytesPerSecond(result.m_InputBytes, result.m_Seconds));
+
+            if (result.m_DroppedFieldCount > 0)
+            {
+                std::cout << "[Converter] " << fileName << ": " << result.m_DroppedFieldCount << " nested or null field(s) have no binary equivalent and were dropped.\n";
+            }
+        }
+    }
+
+    std::vector<AssetConversionResult> AssetConverter::ConvertDirectory(const std::string& inputDirectory, const std::string& outputDirectory, AssetFormat targetFormat, unsigned int threadCount)
+    {
+        if (outputDirectory.empty() || IsSamePath(inputDirectory, outputDirectory))
+        {
+            std::cout << "[Converter] The output directory must differ from the input directory, as fields without an equivalent in the target format are dropped.\n";
+            return { };
+        }
+
+        const std::vector<std::string> sceneFiles = IO::EngineIO::GetSupportedSceneFilesInDirectory(inputDirectory);
+        std::vector<AssetConversionResult> results(sceneFiles.size());
+
+        if (sceneFiles.empty())
+        {
+            std::cout << "[Converter] No " << IO::g_Extension_Scene << " files found in " << inputDirectory << ".\n";
+            return results;
+        }
+
+        if (!IO::FileSystem::Exists(outputDirectory))
+        {
+            IO::FileSystem::CreateDirectory_(outputDirectory);
+        }
+
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = std::min(threadCount, static_cast<unsigned int>(sceneFiles.size()));
+
+        // Every job and one stop signal per worker are queued up front, so the queue never blocks a producer.
+        Utilities::MPMCQueue<size_t> jobQueue(sceneFiles.size() + threadCount);
+        for (size_t i = 0; i < sceneFiles.size(); ++i)
+        {
+            jobQueue.push(i);
+        }
+
+        const size_t stopSignal = sceneFiles.size();
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            jobQueue.push(stopSignal);
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            workers.emplace_back([&]()
+            {
+                for (;;)
+                {
+                    size_t fileIndex = stopSignal;
+                    jobQueue.pop(fileIndex);
+                    if (fileIndex == stopSignal)
+                    {
+                        return;
+                    }
+
+                    const std::string outputPath = (std::filesystem::path(outputDirectory) / std::filesystem::path(sceneFiles[fileIndex]).filename()).string();
+
+                    // Each worker owns its slot in results, so no synchronization is needed beyond the join below.
+                    results[fileIndex] = ConvertFile(sceneFiles[fileIndex], outputPath, targetFormat);
+                    PrintResult(results[fileIndex], targetFormat);
+                }
+            });
+        }
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        const double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        size_t convertedCount = 0, skippedCount = 0, failedCount = 0, totalBytes = 0;
+        for (const AssetConversionResult& result : results)
+        {
+            if (result.m_IsSkipped)
+            {
+                ++skippedCount;
+            }
+            else if (result.m_IsSuccessful)
+            {
+                ++convertedCount;
+                totalBytes += result.m_InputBytes;
+            }
+            else
+            {
+                ++failedCount;
+            }
+        }
+
+        std::printf("[Converter] %zu Converted, %zu Skipped, %zu Failed | %.1f MB in %.2f s on %u Thread(s) | %.1f MB/s\n", convertedCount, skippedCount, failedCount,
+                    totalBytes / (1024.0 * 1024.0), totalSeconds, threadCount, ToMegabytesPerSecond(totalBytes, totalSeconds));
+
+        return results;
+    }
+
+    AssetConversionResult AssetConverter::ConvertFile(const std::string& inputPath, const std::string& outputPath, AssetFormat targetFormat)
+    {
+        AssetConversionResult result;
+        result.m_InputPath = inputPath;
+        result.m_OutputPath = outputPath;
+
+        const AssetFormat sourceFormat = DetectFormat(inputPath);
+        if (sourceFormat == AssetFormat::AssetFormat_Unknown || targetFormat == AssetFormat::AssetFormat_Unknown)
+        {
+            return result;
+        }
+
+        if (sourceFormat == targetFormat)
+        {
+            result.m_IsSkipped = true;
+            return result;
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        // Written beside the destination and moved over it once complete, so a failed conversion never leaves a partial file.
+        const std::string temporaryPath = outputPath + ".converting";
+        const bool isInPlace = IsSamePath(inputPath, outputPath);
+
+        std::error_code errorCode;
+        result.m_InputBytes = static_cast<size_t>(std::filesystem::file_size(inputPath, errorCode));
+
+        bool isConverted = targetFormat == AssetFormat::AssetFormat_Binary ? ConvertYAMLToBinary(inputPath, temporaryPath, result) : ConvertBinaryToYAML(inputPath, temporaryPath, result);
+
+        // The source would be the only copy of the dropped fields.
+        if (isConverted && isInPlace && result.m_DroppedFieldCount > 0)
+        {
+            std::lock_guard<std::mutex> lock(g_ConsoleMutex);
+            std::cout << "[Converter] " << inputPath << " was left as is, as converting it in place would drop " << result.m_DroppedFieldCount << " field(s).\n";
+            isConverted = false;
+        }
+
+        if (isConverted)
+        {
+            std::filesystem::rename(temporaryPath, outputPath, errorCode);
+        }
+
+        if (!isConverted || errorCode)
+        {
+            std::filesystem::remove(temporaryPath, errorCode);
+            return result;
+        }
+
+        result.m_OutputBytes = static_cast<size_t>(std::filesystem::file_size(outputPath, errorCode));
+        result.m_Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        result.m_IsSuccessful = true;
+
+        return result;
+    }
+
+    bool AssetConverter::ConvertYAMLToBinary(const std::string& inputPath, const std::string& outputPath, AssetConversionResult& result)
+    {
+        YAMLSerializer inputSerializer(Serialization_Target::Serialization_Target_Unknown, inputPath);
+        inputSerializer.SetVerbose(false);
+
+        try
+        {
+            inputSerializer.BeginDeserialization();
+        }
+        catch (const YAML::Exception& exception)
+        {
+            std::lock_guard<std::mutex> lock(g_ConsoleMutex);
+            std::cout << "[Converter] " << inputPath << " - " << exception.what() << "\n";
+            return false;
+        }
+
+        if (!inputSerializer.IsVersionVerified())
+        {
+            return false;
+        }
+
+        BinarySerializer outputSerializer(inputSerializer.GetSerializationTarget(), outputPath);
+        outputSerializer.SetVerbose(false);
+        outputSerializer.BeginSerialization();
+
+        // YAML carries no widths, so integers are written as 64-bit and decimals as double. The binary reader converts between numeric types on read.
+        inputSerializer.ForEachField([&](const std::string& keyName, const YAML::Node& node)
+        {
+            switch (YAMLUtilities::GetScalarKind(node))
+            {
+            case YAMLUtilities::ScalarKind::Bool:
+            {
+                bool value = node.as<bool>();
+                outputSerializer.Write(keyName, value);
+                break;
+            }
+
+            case YAMLUtilities::ScalarKind::Integer:
+            {
+                long long value = ScalarAs<long long>(node);
+                outputSerializer.Write(keyName, value);
+                break;
+            }
+
+            case YAMLUtilities::ScalarKind::UnsignedInteger:
+            {
+                unsigned long long value = ScalarAs<unsigned long long>(node);
+                outputSerializer.Write(keyName, value);
+                break;
+            }
+
+            case YAMLUtilities::ScalarKind::Floating:
+            {
+                double value = ScalarAs<double>(node);
+                outputSerializer.Write(keyName, value);
+                break;
+            }
+
+            case YAMLUtilities::ScalarKind::String:
+                if (node.IsScalar())
+                {
+                    outputSerializer.Write(keyName, node.Scalar());
+                    break;
+                }
+
+                ++result.m_DroppedFieldCount;
+                return;
+
+            default:
+                ++result.m_DroppedFieldCount;
+                return;
+            }
+
+            ++result.m_FieldCount;
+        });
+
+        outputSerializer.EndSerialization();
+        inputSerializer.EndDeserialization();
+
+        return true;
+    }
+
+    bool AssetConverter::ConvertBinaryToYAML(const std::string& inputPath, const std::string& outputPath, AssetConversionResult& result)
+    {
+        BinarySerializer inputSerializer(Serialization_Target::Serialization_Target_Unknown, inputPath);
+        inputSerializer.SetVerbose(false);
+        inputSerializer.BeginDeserialization();
+
+        if (!inputSerializer.IsVersionVerified())
+        {
+            return false;
+        }
+
+        YAMLSerializer outputSerializer(inputSerializer.GetSerializationTarget(), outputPath);
+        outputSerializer.SetVerbose(false);
+        outputSerializer.EnableStreaming();
+        outputSerializer.BeginSerialization();
+
+        inputSerializer.ForEachField([&](const std::string& keyName, const BinaryUtilities::BinaryValue& value)
+        {
+            using BinaryUtilities::BinaryTypeTag;
+
+            switch (value.m_TypeTag)
+            {
+            case BinaryTypeTag::Bool:
+            {
+                bool boolValue = value.m_Bool;
+                outputSerializer.Write(keyName, boolValue);
+                break;
+            }
+
+            case BinaryTypeTag::Float:
+            {
+                // Narrowed back so the YAML holds the float's shortest form rather than its double expansion.
+                float floatValue = static_cast<float>(value.m_Floating);
+                outputSerializer.Write(keyName, floatValue);
+                break;
+            }
+
+            case BinaryTypeTag::Double:
+            {
+                double doubleValue = value.m_Floating;
+                outputSerializer.Write(keyName, doubleValue);
+                break;
+            }
+
+            case BinaryTypeTag::String:
+                outputSerializer.Write(keyName, value.m_String);
+                break;
+
+            default:
+                if (value.IsSigned())
+                {
+                    long long signedValue = value.m_Signed;
+                    outputSerializer.Write(keyName, signedValue);
+                }
+                else
+                {
+                    unsigned long long unsignedValue = value.m_Unsigned;
+                    outputSerializer.Write(keyName, unsignedValue);
+                }
+                break;
+            }
+
+            ++result.m_FieldCount;
+        });
+
+        outputSerializer.EndSerialization();
+        inputSerializer.EndDeserialization();
+
+        return true;
+    }
+
+    AssetFormat AssetConverter::DetectFormat(const std::string& filePath)
+    {
+        std::ifstream inputFile(filePath, std::ios::binary);
+        char header[sizeof(BinaryUtilities::g_BinaryMagic)] = {};
+        inputFile.read(header, sizeof(header));
+
+        const std::streamsize headerSize = inputFile.gcount();
+        if (headerSize == sizeof(header) && std::equal(header, header + sizeof(header), BinaryUtilities::g_BinaryMagic))
+        {
+            return AssetFormat::AssetFormat_Binary;
+        }
+
+        // Anything else with a NUL up front is binary we can't read (i.e. files written before records were tagged).
+        if (headerSize == 0 || std::find(header, header + headerSize, '\0') != header + headerSize)
+        {
+            return AssetFormat::AssetFormat_Unknown;
+        }
+
+        return AssetFormat::AssetFormat_YAML;
+    }
+
+    AssetFormat AssetConverter::StringToAssetFormat(const std::string& formatName)
+    {
+        const std::string lowercaseName = StringUtilities::ConvertToLowercase(formatName);
+
+        if (lowercaseName == "yaml" || lowercaseName == "yml")
+        {
+            return AssetFormat::AssetFormat_YAML;
+        }
+
+        if (lowercaseName == "binary" || lowercaseName == "bin")
+        {
+            return AssetFormat::AssetFormat_Binary;
+        }
+
+        return AssetFormat::AssetFormat_Unknown;
+    }
+
+    const char* AssetConverter::AssetFormatToString(AssetFormat assetFormat)
+    {
+        switch (assetFormat)
+        {
+        case AssetFormat::AssetFormat_YAML:
+            return "YAML";
+
+        case AssetFormat::AssetFormat_Binary:
+            return "Binary";
+
+        default:
+            return "Unknown";
+        }
+    }
+
+    int AssetConverter::RunFromCommandLine(int argc, char* argv[])
+    {
+        if (argc < 3 || StringToAssetFormat(argv[0]) == AssetFormat::AssetFormat_Unknown)
+        {
+            std::cout << "Usage: convert <yaml|binary> <inputDirectory> <outputDirectory> [threadCount]\n";
+            return 1;
+        }
+
+        const AssetFormat targetFormat = StringToAssetFormat(argv[0]);
+        const std::string inputDirectory = argv[1];
+        const std::string outputDirectory = argv[2];
+        const unsigned int threadCount = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 0;
+
+        if (!IO::FileSystem::IsDirectory(inputDirectory))
+        {
+            std::cout << "[Converter] " << inputDirectory << " is not a directory.\n";
+            return 1;
+        }
+
+        if (IsSamePath(inputDirectory, outputDirectory))
+        {
+            std::cout << "[Converter] The output directory must differ from the input directory, as fields without an equivalent in the target format are dropped.\n";
+            return 1;
+        }
+
+        const std::vector<AssetConversionResult> results = ConvertDirectory(inputDirectory, outputDirectory, targetFormat, threadCount);
+        const bool hasFailures = std::any_of(results.begin(), results.end(), [](const AssetConversionResult& result) { return !result.m_IsSuccessful && !result.m_IsSkipped; });
+
+        return hasFailures ? 1 : 0;
+    }
+}
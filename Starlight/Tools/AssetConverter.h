@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Tools
+{
+    enum class AssetFormat
+    {
+        AssetFormat_YAML,
+        AssetFormat_Binary,
+        AssetFormat_Unknown
+    };
+
+    struct AssetConversionResult
+    {
+        std::string m_InputPath;
+        std::string m_OutputPath;
+        bool m_IsSuccessful = false;
+        bool m_IsSkipped = false;       // Already in the requested format.
+        size_t m_InputBytes = 0;
+        size_t m_OutputBytes = 0;
+        size_t m_FieldCount = 0;
+        size_t m_DroppedFieldCount = 0; // Fields with no equivalent in the target format (i.e. nested YAML nodes when converting to binary).
+        double m_Seconds = 0.0;
+    };
+
+    // Transcodes .starlight assets between the YAML and binary serializer formats. Files in a directory are converted in parallel on a pool of worker threads.
+    class AssetConverter
+    {
+    public:
+        // Converts every .starlight file in inputDirectory to targetFormat, written under the same name into outputDirectory, which must be a different directory. A thread count of 0 uses every hardware thread.
+        static std::vector<AssetConversionResult> ConvertDirectory(const std::string& inputDirectory, const std::string& outputDirectory, AssetFormat targetFormat, unsigned int threadCount = 0);
+
+        // Converting a file onto itself fails, leaving it untouched, if any field would be dropped.
+        static AssetConversionResult ConvertFile(const std::string& inputPath, const std::string& outputPath, AssetFormat targetFormat);
+
+        // Sniffs the file header rather than trusting the extension, as both formats share .starlight.
+        static AssetFormat DetectFormat(const std::string& filePath);
+
+        static AssetFormat StringToAssetFormat(const std::string& formatName);
+        static const char* AssetFormatToString(AssetFormat assetFormat);
+
+        // Usage: convert <yaml|binary> <inputDirectory> <outputDirectory> [threadCount]. Returns the process exit code.
+        static int RunFromCommandLine(int argc, char* argv[]);
+
+    private:
+        static bool ConvertYAMLToBinary(const std::string& inputPath, const std::string& outputPath, AssetConversionResult& result);
+        static bool ConvertBinaryToYAML(const std::string& inputPath, const std::string& outputPath, AssetConversionResult& result);
+    };
+}
@@ -0,0 +1,225 @@
+#include "LogDecoder.h"
+#include "../Log/LogBinaryFormat.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <json/json.hpp>
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+namespace Tools
+{
+    namespace
+    {
+        struct DecodedLogSite
+        {
+            Aurora::LogBinaryMessage m_MessageKind = Aurora::LogBinaryMessage::Raw;
+            std::string m_LogMessage;
+            std::string m_FilePath;
+            std::string m_FunctionName;
+            int m_LineNumber = 0;
+        };
+
+        // Reads a record's arguments into argumentStore. Strings are views into the file's contents, which outlive the store.
+        bool ReadArguments(Aurora::LogBinaryReader& binaryReader, fmt::dynamic_format_arg_store<fmt::format_context>& argumentStore)
+        {
+            const uint64_t argumentCount = binaryReader.ReadVarint();
+
+            for (uint64_t argumentIndex = 0; argumentIndex < argumentCount && binaryReader.IsValid(); ++argumentIndex)
+            {
+                switch (static_cast<Aurora::LogBinaryArgument>(binaryReader.ReadByte()))
+                {
+                    case Aurora::LogBinaryArgument::Int:
+                        argumentStore.push_back(binaryReader.ReadSignedVarint());
+                        break;
+
+                    case Aurora::LogBinaryArgument::UInt:
+                        argumentStore.push_back(binaryReader.ReadVarint());
+                        break;
+
+                    case Aurora::LogBinaryArgument::Double:
+                        argumentStore.push_back(binaryReader.ReadDouble());
+                        break;
+
+                    case Aurora::LogBinaryArgument::Float:
+                        argumentStore.push_back(binaryReader.ReadFloat());
+                        break;
+
+                    case Aurora::LogBinaryArgument::Bool:
+                        argumentStore.push_back(binaryReader.ReadByte() != 0);
+                        break;
+
+                    case Aurora::LogBinaryArgument::Char:
+                        argumentStore.push_back(static_cast<char>(binaryReader.ReadByte()));
+                        break;
+
+                    case Aurora::LogBinaryArgument::String:
+                        argumentStore.push_back(binaryReader.ReadString());
+                        break;
+
+                    default:
+                        return false;
+                }
+            }
+
+            return binaryReader.IsValid();
+        }
+
+        std::string BuildMessage(const DecodedLogSite& logSite, const fmt::dynamic_format_arg_store<fmt::format_context>& argumentStore)
+        {
+            if (logSite.m_MessageKind == Aurora::LogBinaryMessage::Raw)
+            {
+                return logSite.m_LogMessage;
+            }
+
+            // Preformatted records hold the message as their only argument.
+            const std::string_view formatString = logSite.m_MessageKind == Aurora::LogBinaryMessage::Preformatted ? std::string_view("{}") : std::string_view(logSite.m_LogMessage);
+
+            try
+            {
+                return fmt::vformat(formatString, argumentStore);
+            }
+            catch (const fmt::format_error& formatError)
+            {
+                return fmt::format("{} [Format Error: {}]", logSite.m_LogMessage, formatError.what());
+            }
+        }
+    }
+
+    bool LogDecoder::DecodeFile(const std::string& filePath, const RecordHandler& recordHandler)
+    {
+        std::ifstream inputFile(filePath, std::ios::binary);
+        if (!inputFile)
+        {
+            return false;
+        }
+
+        const std::string fileContents((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+        Aurora::LogBinaryReader binaryReader(fileContents);
+
+        const std::string_view magic = binaryReader.ReadBytes(sizeof(Aurora::LogBinaryMagic));
+        if (magic.size() != sizeof(Aurora::LogBinaryMagic) || !std::equal(magic.begin(), magic.end(), Aurora::LogBinaryMagic) || binaryReader.ReadUInt32() != Aurora::LogBinaryVersion)
+        {
+            return false;
+        }
+
+        int64_t logTime = binaryReader.ReadSignedVarint();
+
+        std::vector<DecodedLogSite> logSites;
+        DecodedLogRecord decodedRecord;
+        fmt::dynamic_format_arg_store<fmt::format_context> argumentStore;
+
+        while (binaryReader.IsValid() && !binaryReader.IsAtEnd())
+        {
+            const Aurora::LogBinaryEntry entryType = static_cast<Aurora::LogBinaryEntry>(binaryReader.ReadByte());
+
+            if (entryType == Aurora::LogBinaryEntry::Site)
+            {
+                const uint64_t siteID = binaryReader.ReadVarint();
+                if (siteID != logSites.size())
+                {
+                    return false;
+                }
+
+                DecodedLogSite& logSite = logSites.emplace_back();
+                logSite.m_MessageKind = static_cast<Aurora::LogBinaryMessage>(binaryReader.ReadByte());
+                logSite.m_LogMessage = binaryReader.ReadString();
+                logSite.m_FilePath = binaryReader.ReadString();
+                logSite.m_FunctionName = binaryReader.ReadString();
+                logSite.m_LineNumber = static_cast<int>(binaryReader.ReadVarint());
+            }
+            else if (entryType == Aurora::LogBinaryEntry::Record)
+            {
+                const uint64_t siteID = binaryReader.ReadVarint();
+                if (siteID >= logSites.size())
+                {
+                    return false;
+                }
+
+                const DecodedLogSite& logSite = logSites[static_cast<size_t>(siteID)];
+                logTime += binaryReader.ReadSignedVarint();
+
+                decodedRecord.m_LogTime = logTime;
+                decodedRecord.m_LogLayer = static_cast<Aurora::LogLayer>(binaryReader.ReadByte());
+                decodedRecord.m_LogLevel = static_cast<Aurora::LogLevel>(binaryReader.ReadByte());
+                decodedRecord.m_DebugCode = static_cast<Aurora::DebugCode>(binaryReader.ReadVarint());
+
+                argumentStore.clear();
+                if (!ReadArguments(binaryReader, argumentStore))
+                {
+                    return false;
+                }
+
+                decodedRecord.m_LogMessage = BuildMessage(logSite, argumentStore);
+                decodedRecord.m_FilePath = logSite.m_FilePath;
+                decodedRecord.m_FunctionName = logSite.m_FunctionName;
+                decodedRecord.m_LineNumber = logSite.m_LineNumber;
+
+                recordHandler(decodedRecord);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return binaryReader.IsValid();
+    }
+
+    std::string LogDecoder::ToText(const DecodedLogRecord& decodedRecord)
+    {
+        const time_t logTime = static_cast<time_t>(decodedRecord.m_LogTime / 1000000000);
+        const int64_t microseconds = (decodedRecord.m_LogTime % 1000000000) / 1000;
+
+        char timeText[80] = {};
+        struct std::tm timeStruct = *localtime(&logTime);
+        strftime(timeText, sizeof(timeText), "%Y-%m-%d %X", &timeStruct);
+
+        return fmt::format("[{0}][{1}.{2:06}] {3} (Line {4}, {5}) \n", Aurora::LogLevelToString(decodedRecord.m_LogLevel), timeText, microseconds, decodedRecord.m_LogMessage, decodedRecord.m_LineNumber, decodedRecord.m_FilePath);
+    }
+
+    std::string LogDecoder::ToJSON(const DecodedLogRecord& decodedRecord)
+    {
+        nlohmann::json record;
+
+        record["time"] = decodedRecord.m_LogTime;
+        record["layer"] = Aurora::LogLayerToString(decodedRecord.m_LogLayer);
+        record["level"] = Aurora::LogLevelToString(decodedRecord.m_LogLevel);
+        record["debugCode"] = Aurora::DebugCodeToString(decodedRecord.m_DebugCode);
+        record["message"] = decodedRecord.m_LogMessage;
+        record["file"] = decodedRecord.m_FilePath;
+        record["function"] = decodedRecord.m_FunctionName;
+        record["line"] = decodedRecord.m_LineNumber;
+
+        // Replaces invalid UTF-8 rather than throwing, as messages can hold any bytes.
+        return record.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) + "\n";
+    }
+
+    int LogDecoder::RunFromCommandLine(int argc, char* argv[])
+    {
+        if (argc < 1)
+        {
+            std::cout << "Usage: decode-log <inputFile> [--json]\n";
+            return 1;
+        }
+
+        const std::string inputPath = argv[0];
+        const bool isJSON = argc > 1 && std::string(argv[1]) == "--json";
+
+        const bool isSuccessful = DecodeFile(inputPath, [&](const DecodedLogRecord& decodedRecord)
+        {
+            std::cout << (isJSON ? ToJSON(decodedRecord) : ToText(decodedRecord));
+        });
+
+        if (!isSuccessful)
+        {
+            std::cerr << "[LogDecoder] " << inputPath << " is not a binary log, or is cut short.\n";
+            return 1;
+        }
+
+        return 0;
+    }
+}
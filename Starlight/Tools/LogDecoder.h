@@ -0,0 +1,41 @@
+#pragma once
+#include "../Log/LogClassification.h"
+#include "../Debug/DebugCode.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Tools
+{
+    // A record from a binary log, with its message rebuilt.
+    struct DecodedLogRecord
+    {
+        int64_t m_LogTime = 0;  // Wall clock nanoseconds since the epoch.
+        Aurora::LogLayer m_LogLayer = Aurora::LogLayer::Unknown;
+        Aurora::LogLevel m_LogLevel = Aurora::LogLevel::Unknown;
+        Aurora::DebugCode m_DebugCode = Aurora::DebugCode::AURORA_MAX_ENUM;
+        std::string m_LogMessage;
+        std::string m_FilePath;
+        std::string m_FunctionName;
+        int m_LineNumber = 0;
+    };
+
+    // Turns files written by Aurora::BinaryLogSink back into text or JSON. See Log/LogBinaryFormat.h for the layout.
+    class LogDecoder
+    {
+    public:
+        using RecordHandler = std::function<void(const DecodedLogRecord&)>;
+
+        // Calls recordHandler for each record in order. Returns false if the file isn't a binary log or is cut short, after handling every record before that point.
+        static bool DecodeFile(const std::string& filePath, const RecordHandler& recordHandler);
+
+        // As the console logger prints it, with the date and microseconds added to the time.
+        static std::string ToText(const DecodedLogRecord& decodedRecord);
+
+        // A single line JSON object, so that a decoded file is JSON Lines.
+        static std::string ToJSON(const DecodedLogRecord& decodedRecord);
+
+        // Usage: decode-log <inputFile> [--json]. Writes to standard output. Returns the process exit code.
+        static int RunFromCommandLine(int argc, char* argv[]);
+    };
+}
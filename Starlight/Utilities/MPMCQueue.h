@@ -151,7 +151,7 @@ namespace Utilities
             // Ensure that our constructor doesn't throw runtime exceptions.
             static_assert(std::is_nothrow_constructible<T, Args&&...>::value, "T must be nothrow constructible with Args&&...");
 
-            const unsigned long long head = m_Head.fetch_add(1); // Current Head + 1
+            const size_t head = m_Head.fetch_add(1); // Current Head + 1
             auto& slot = m_Slots[Index(head)]; // Grabs a slot with the index of our current head. 
 
             // Wait for our turn to write slot.
@@ -170,7 +170,7 @@ namespace Utilities
         bool try_emplace(Args&&... args) noexcept
         {
             static_assert(std::is_nothrow_constructible<T, Args&&...>::value, "T must be nothrow constructible with Args&&...");
-            unsigned long long head = m_Head.load(std::memory_order_acquire);
+            size_t head = m_Head.load(std::memory_order_acquire);
 
             for (;;)
             {
@@ -205,7 +205,7 @@ namespace Utilities
 
         bool try_push(const T& value) noexcept
         {
-            static_assert(std::is_nothrow_copy_constructible<T>::Value, "T must be a nothrow copy constructible.");
+            static_assert(std::is_nothrow_copy_constructible<T>::value, "T must be a nothrow copy constructible.");
             return try_emplace(value);
         }
 
@@ -218,7 +218,7 @@ namespace Utilities
         void pop(T& value) noexcept
         {
             // Acquire a read ticket from the tail. 
-            const unsigned long long tail = m_Tail.fetch_add(1);
+            const size_t tail = m_Tail.fetch_add(1);
             auto& slot = m_Slots[Index(tail)];
 
             // Wait for our turn to read the slot. 
@@ -235,11 +235,11 @@ namespace Utilities
         
         bool try_pop(T& value) noexcept
         {
-            unsigned long long tail = m_Tail.load(std::memory_order_acquire);
+            size_t tail = m_Tail.load(std::memory_order_acquire);
             for (;;)
             {
                 auto& slot = m_Slots[Index(tail)];
-                if (Turn(tail) * 2 + 1 == slot.m_Turn().load(std::memory_order_acquire))
+                if (Turn(tail) * 2 + 1 == slot.m_Turn.load(std::memory_order_acquire))
                 {
                     if (m_Tail.compare_exchange_strong(tail, tail + 1))
                     {
@@ -273,7 +273,7 @@ namespace Utilities
         // All objects specify a size oif at least 1 even if the type is empty. However, no_unique_address indicates that the data member need not have an address distinct from other non-static data members.
         // This means that the compiler may optimise it to occupy no space, just like if it were an empty base. If the member is not empty, any tail padding in it may be reused to store other data members.
 #if defined (__has_cpp_attribute) && __has_cpp_attribute(no_unique_address) 
-        Allocator m_Allocator_ [[no_unique_address]];
+        Allocator m_Allocator [[no_unique_address]];
 #else
         Allocator m_Allocator;
 #endif